@@ -0,0 +1,101 @@
+#include <atomic>
+#include <malloc.h>
+#include <string.h>
+#include "AllocationTracker.h"
+
+// glibc's internal entry points, used to forward the intercepted calls without recursion.
+extern "C"
+{
+    void *__libc_malloc(size_t size);
+    void *__libc_calloc(size_t count, size_t size);
+    void *__libc_realloc(void *ptr, size_t size);
+    void __libc_free(void *ptr);
+}
+
+namespace
+{
+    std::atomic<uint64_t> allocations{0};
+    std::atomic<uint64_t> frees{0};
+    std::atomic<int64_t> liveBytes{0};
+    std::atomic<int64_t> peakBytes{0};
+
+    void recordAllocation(void *ptr)
+    {
+        if (!ptr)
+            return;
+        allocations.fetch_add(1, std::memory_order_relaxed);
+        const int64_t live = liveBytes.fetch_add(malloc_usable_size(ptr), std::memory_order_relaxed) + malloc_usable_size(ptr);
+        int64_t peak = peakBytes.load(std::memory_order_relaxed);
+        while (live > peak && !peakBytes.compare_exchange_weak(peak, live, std::memory_order_relaxed))
+        {
+        }
+    }
+
+    void recordFree(void *ptr)
+    {
+        if (!ptr)
+            return;
+        frees.fetch_add(1, std::memory_order_relaxed);
+        liveBytes.fetch_sub(malloc_usable_size(ptr), std::memory_order_relaxed);
+    }
+}
+
+extern "C"
+{
+    void *malloc(size_t size)
+    {
+        void *ptr = __libc_malloc(size);
+        recordAllocation(ptr);
+        return ptr;
+    }
+
+    void *calloc(size_t count, size_t size)
+    {
+        void *ptr = __libc_calloc(count, size);
+        recordAllocation(ptr);
+        return ptr;
+    }
+
+    void *realloc(void *ptr, size_t size)
+    {
+        if (!ptr)
+            return malloc(size);
+        if (size == 0)
+        {
+            free(ptr);
+            return nullptr;
+        }
+        const size_t oldSize = malloc_usable_size(ptr);
+        void *result = __libc_realloc(ptr, size);
+        if (result)
+        {
+            // Account for a resize as releasing the old block and allocating the new one.
+            liveBytes.fetch_sub(oldSize, std::memory_order_relaxed);
+            recordAllocation(result);
+            frees.fetch_add(1, std::memory_order_relaxed);
+        }
+        return result;
+    }
+
+    void free(void *ptr)
+    {
+        recordFree(ptr);
+        __libc_free(ptr);
+    }
+}
+
+namespace AllocationTracker
+{
+    Snapshot snapshot()
+    {
+        return {allocations.load(std::memory_order_relaxed),
+                frees.load(std::memory_order_relaxed),
+                liveBytes.load(std::memory_order_relaxed),
+                peakBytes.load(std::memory_order_relaxed)};
+    }
+
+    void resetPeak()
+    {
+        peakBytes.store(liveBytes.load(std::memory_order_relaxed), std::memory_order_relaxed);
+    }
+}
@@ -0,0 +1,35 @@
+#ifndef __H_ALLOCATION_TRACKER__
+#define __H_ALLOCATION_TRACKER__
+#include <stddef.h>
+#include <stdint.h>
+
+/**
+ * @brief Process-wide heap accounting for the benchmarks.
+ *
+ * `malloc`/`realloc`/`free` (and therefore `new`/`delete` and the `String` shim) are intercepted,
+ * so every heap allocation the library performs is counted, including the ones done through `realloc`.
+ *
+ */
+namespace AllocationTracker
+{
+    struct Snapshot
+    {
+        /// @brief Number of successful allocations (a growing `realloc` counts as one).
+        uint64_t allocations;
+        /// @brief Number of blocks released.
+        uint64_t frees;
+        /// @brief Bytes currently allocated.
+        int64_t liveBytes;
+        /// @brief Highest `liveBytes` value since the last `resetPeak()`.
+        int64_t peakBytes;
+    };
+
+    Snapshot snapshot();
+
+    /**
+     * @brief Sets the peak to the current live byte count, so the next peak is relative to now.
+     */
+    void resetPeak();
+}
+
+#endif // __H_ALLOCATION_TRACKER__
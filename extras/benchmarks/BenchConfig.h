@@ -0,0 +1,275 @@
+#ifndef __H_BENCH_CONFIG__
+#define __H_BENCH_CONFIG__
+#include <array>
+#include <config-handler-core.h>
+
+/**
+ * @brief The kinds of parameters a synthetic configuration cycles through, so every built-in validator is exercised.
+ *
+ */
+enum class BenchParameterKind : uint8_t
+{
+    INT,
+    FLOAT,
+    BOOL,
+    STRING,
+    OPTION,
+};
+
+inline BenchParameterKind benchParameterKind(size_t index)
+{
+    return static_cast<BenchParameterKind>(index % 5);
+}
+
+inline String benchParameterName(size_t index)
+{
+    // Longer than the String's inline buffer, like most real parameter names ("wifiPassword", "mqttBrokerHost", ...).
+    return String("parameter_") + static_cast<unsigned int>(index);
+}
+
+/**
+ * @brief A value that is valid for the parameter at `index`; `variant` selects between different valid values.
+ */
+inline String benchParameterValue(size_t index, unsigned int variant)
+{
+    switch (benchParameterKind(index))
+    {
+    case BenchParameterKind::INT:
+        return String((index * 7 + variant) % 100);
+    case BenchParameterKind::FLOAT:
+        return String(variant % 2 == 0 ? "12.5" : "-3.25");
+    case BenchParameterKind::BOOL:
+        return String(variant % 2 == 0 ? "true" : "false");
+    case BenchParameterKind::STRING:
+        return String("value-for-parameter-") + static_cast<unsigned int>(index) + "-" + variant;
+    case BenchParameterKind::OPTION:
+    default:
+        return String("option-") + (variant % 4);
+    }
+}
+
+inline std::vector<String> benchOptions()
+{
+    return {"option-0", "option-1", "option-2", "option-3"};
+}
+
+struct BenchValue
+{
+    int32_t intValue;
+    float floatValue;
+    bool boolValue;
+    String stringValue;
+};
+
+/**
+ * @brief A synthetic configuration type with `ParameterCount` parameters.
+ *
+ * @tparam Index Distinguishes configurations in the same sweep (each one has its own title and file).
+ * @tparam ParameterCount The number of parameters in the configuration.
+ */
+template <size_t Index, size_t ParameterCount>
+struct BenchConfig
+{
+    std::array<BenchValue, ParameterCount> values;
+};
+
+template <size_t Index, size_t ParameterCount>
+struct ConfigurationFunctions<BenchConfig<Index, ParameterCount>>
+{
+    static ConfigInfo getConfigInfo()
+    {
+        std::vector<ParameterInfo> parameters;
+        parameters.reserve(ParameterCount);
+        for (size_t i = 0; i < ParameterCount; i++)
+        {
+            const String name = benchParameterName(i);
+            switch (benchParameterKind(i))
+            {
+            case BenchParameterKind::INT:
+                parameters.push_back(numericParameter(name, ParameterAttribute::ATTR_NONE, 0, 100));
+                break;
+            case BenchParameterKind::FLOAT:
+                parameters.push_back(floatParameter(name, ParameterAttribute::ATTR_NONE, -100, 100));
+                break;
+            case BenchParameterKind::BOOL:
+                parameters.push_back(booleanParameter(name, ParameterAttribute::ATTR_NONE));
+                break;
+            case BenchParameterKind::STRING:
+                parameters.push_back(stringParameter(name, ParameterAttribute::ATTR_NONE, 64));
+                break;
+            case BenchParameterKind::OPTION:
+                parameters.push_back(optionSetParameter(name, ParameterAttribute::ATTR_NONE, benchOptions));
+                break;
+            }
+        }
+        return {getTitle(), parameters};
+    }
+
+    static String getConfigFileName()
+    {
+        return String("/bench_") + static_cast<unsigned int>(Index) + ".conf";
+    }
+
+    static std::vector<String> getOptionsFor(const String &parameterName)
+    {
+        return benchOptions();
+    }
+
+    static void save(const std::map<String, String> &values, StorageMedium::FileHandler &fileHandler)
+    {
+        for (size_t i = 0; i < ParameterCount; i++)
+        {
+            const String name = benchParameterName(i);
+            const String &value = values.at(name);
+            switch (benchParameterKind(i))
+            {
+            case BenchParameterKind::INT:
+                fileHandler.write<int32_t>(name, value.toInt());
+                break;
+            case BenchParameterKind::FLOAT:
+                fileHandler.write<float>(name, value.toFloat());
+                break;
+            case BenchParameterKind::BOOL:
+                fileHandler.write<bool>(name, value.equalsIgnoreCase("true"));
+                break;
+            case BenchParameterKind::STRING:
+            case BenchParameterKind::OPTION:
+                fileHandler.write<String>(name, value);
+                break;
+            }
+        }
+    }
+
+    static void save(const ParameterValuesView &values, StorageMedium::FileHandler &fileHandler)
+    {
+        // The values were already parsed when they were set, use the typed form rather than parsing them again,
+        // and write them all in one batch.
+        std::array<BenchValue, ParameterCount> converted;
+        std::vector<StorageMedium::BatchEntry> entries;
+        entries.reserve(ParameterCount);
+        size_t i = 0;
+        for (auto it = values.begin(); it != values.end(); ++it, i++)
+        {
+            const auto &[name, value] = *it;
+            const TypedValue &typed = it.typed();
+            BenchValue &target = converted[i];
+            switch (benchParameterKind(i))
+            {
+            case BenchParameterKind::INT:
+                target.intValue = typed.getKind() == TypedValue::Kind::INT ? static_cast<int32_t>(typed.asInt()) : value.toInt();
+                entries.emplace_back(name, &target.intValue);
+                break;
+            case BenchParameterKind::FLOAT:
+                target.floatValue = typed.getKind() == TypedValue::Kind::FLOAT ? static_cast<float>(typed.asFloat()) : value.toFloat();
+                entries.emplace_back(name, &target.floatValue);
+                break;
+            case BenchParameterKind::BOOL:
+                target.boolValue = typed.getKind() == TypedValue::Kind::BOOL ? typed.asBool() : value.equalsIgnoreCase("true");
+                entries.emplace_back(name, &target.boolValue);
+                break;
+            case BenchParameterKind::STRING:
+            case BenchParameterKind::OPTION:
+                entries.emplace_back(name, &value);
+                break;
+            }
+        }
+        fileHandler.writeBatch(entries);
+    }
+
+    static std::map<String, String> loadAsMap(const StorageMedium::FileHandler &fileHandler)
+    {
+        std::map<String, String> values;
+        for (size_t i = 0; i < ParameterCount; i++)
+        {
+            const String name = benchParameterName(i);
+            switch (benchParameterKind(i))
+            {
+            case BenchParameterKind::INT:
+                values[name] = String(fileHandler.read<int32_t>(name));
+                break;
+            case BenchParameterKind::FLOAT:
+                values[name] = String(fileHandler.read<float>(name));
+                break;
+            case BenchParameterKind::BOOL:
+                values[name] = fileHandler.read<bool>(name) ? "true" : "false";
+                break;
+            case BenchParameterKind::STRING:
+            case BenchParameterKind::OPTION:
+                values[name] = fileHandler.read<String>(name);
+                break;
+            }
+        }
+        return values;
+    }
+
+    static BenchConfig<Index, ParameterCount> loadAsObject(const StorageMedium::FileHandler &fileHandler)
+    {
+        BenchConfig<Index, ParameterCount> config{};
+        const std::vector<String> &names = getNames();
+        std::vector<StorageMedium::BatchEntry> entries;
+        entries.reserve(ParameterCount);
+        for (size_t i = 0; i < ParameterCount; i++)
+        {
+            BenchValue &value = config.values[i];
+            switch (benchParameterKind(i))
+            {
+            case BenchParameterKind::INT:
+                entries.emplace_back(names[i], &value.intValue);
+                break;
+            case BenchParameterKind::FLOAT:
+                entries.emplace_back(names[i], &value.floatValue);
+                break;
+            case BenchParameterKind::BOOL:
+                entries.emplace_back(names[i], &value.boolValue);
+                break;
+            case BenchParameterKind::STRING:
+            case BenchParameterKind::OPTION:
+                entries.emplace_back(names[i], &value.stringValue);
+                break;
+            }
+        }
+        fileHandler.readBatch(entries);
+        return config;
+    }
+
+    static const ValidationResult validate(const std::map<String, String> &values)
+    {
+        // A typical cross-parameter rule that always holds for the generated values, so every pass does the full work.
+        const auto &it = values.find(benchParameterName(0));
+        if (it != values.end() && it->second.toInt() >= 1000)
+            return ValidationResult::Failure(getTitle() + ": first parameter is too large");
+        return ValidationResult::Success();
+    }
+
+    static const ValidationResult validate(const ParameterValuesView &values)
+    {
+        const auto &it = values.find(benchParameterName(0));
+        if (it != values.end() && it.typed().getKind() == TypedValue::Kind::INT && it.typed().asInt() >= 1000)
+            return ValidationResult::Failure(getTitle() + ": first parameter is too large");
+        return ValidationResult::Success();
+    }
+
+private:
+    /**
+     * @brief The parameters' names, built once (batch entries refer to their keys).
+     */
+    static const std::vector<String> &getNames()
+    {
+        static const std::vector<String> names = []()
+        {
+            std::vector<String> result;
+            result.reserve(ParameterCount);
+            for (size_t i = 0; i < ParameterCount; i++)
+                result.push_back(benchParameterName(i));
+            return result;
+        }();
+        return names;
+    }
+
+    static String getTitle()
+    {
+        return String("Bench config ") + static_cast<unsigned int>(Index);
+    }
+};
+
+#endif // __H_BENCH_CONFIG__
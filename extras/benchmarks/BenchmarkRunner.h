@@ -0,0 +1,120 @@
+#ifndef __H_BENCHMARK_RUNNER__
+#define __H_BENCHMARK_RUNNER__
+#include <algorithm>
+#include <chrono>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+#include <vector>
+#include <MemoryStorageMedium.h>
+#include "AllocationTracker.h"
+
+/**
+ * @brief The measurements of a single operation, over all of its iterations.
+ *
+ */
+struct BenchmarkResult
+{
+    const char *operation;
+    size_t configurations;
+    size_t parameters;
+    size_t iterations;
+    double medianNs;
+    double meanNs;
+    double allocationsPerOp;
+    int64_t peakBytes;
+    /// @brief Existence checks, opens, reads and writes performed on the storage medium per operation.
+    double mediumOpsPerOp;
+    /// @brief Simulated storage latency per operation, according to the medium's latency model.
+    double simulatedMicrosPerOp;
+};
+
+/**
+ * @brief Runs operations repeatedly and reports time, allocation count and peak heap usage per operation.
+ *
+ */
+class BenchmarkRunner
+{
+public:
+    BenchmarkRunner(size_t iterations, bool csv, const char *filter)
+        : iterations(iterations), csv(csv), filter(filter) {}
+
+    /**
+     * @brief Measure `operation` (a callable without arguments) and print the result.
+     *
+     * The operation runs once untimed to warm caches and lazily initialized state, then `iterations` times.
+     * The activity of `medium` (if given) during the timed runs is reported as well.
+     */
+    template <typename Operation>
+    void run(const char *name, size_t configurations, size_t parameters, MemoryStorageMedium *medium, Operation &&operation)
+    {
+        if (filter && !strstr(name, filter))
+            return;
+
+        operation();
+        if (medium)
+            medium->resetStatistics();
+
+        std::vector<double> samples;
+        samples.reserve(iterations);
+        int64_t peak = 0;
+        const AllocationTracker::Snapshot before = AllocationTracker::snapshot();
+        for (size_t i = 0; i < iterations; i++)
+        {
+            AllocationTracker::resetPeak();
+            const int64_t liveAtStart = AllocationTracker::snapshot().liveBytes;
+            const auto start = std::chrono::steady_clock::now();
+            operation();
+            const auto end = std::chrono::steady_clock::now();
+            peak = std::max(peak, AllocationTracker::snapshot().peakBytes - liveAtStart);
+            samples.push_back(std::chrono::duration<double, std::nano>(end - start).count());
+        }
+        const AllocationTracker::Snapshot after = AllocationTracker::snapshot();
+        const double allocations = static_cast<double>(after.allocations - before.allocations) / iterations;
+        double mediumOps = 0;
+        double simulatedMicros = 0;
+        if (medium)
+        {
+            const MemoryStorageMedium::Statistics statistics = medium->getStatistics();
+            mediumOps = static_cast<double>(statistics.lookups + statistics.opens + statistics.reads + statistics.writes) / iterations;
+            simulatedMicros = static_cast<double>(statistics.simulatedMicros) / iterations;
+        }
+
+        double total = 0;
+        for (const double sample : samples)
+            total += sample;
+        std::sort(samples.begin(), samples.end());
+
+        report({name, configurations, parameters, iterations, samples[samples.size() / 2], total / samples.size(), allocations, peak, mediumOps, simulatedMicros});
+    }
+
+    void printHeader() const
+    {
+        if (csv)
+            printf("operation,configs,params,iterations,median_ns,mean_ns,allocs_per_op,peak_heap_bytes,medium_ops_per_op,simulated_us_per_op\n");
+        else
+            printf("%-34s %7s %6s %14s %14s %12s %12s %12s %12s\n", "operation", "configs", "params", "median ns/op", "mean ns/op", "allocs/op", "peak heap B",
+                   "medium ops", "flash us/op");
+    }
+
+private:
+    const size_t iterations;
+    const bool csv;
+    const char *filter;
+
+    void report(const BenchmarkResult &result) const
+    {
+        if (csv)
+            printf("%s,%zu,%zu,%zu,%.0f,%.0f,%.1f,%lld,%.1f,%.0f\n", result.operation, result.configurations, result.parameters, result.iterations,
+                   result.medianNs, result.meanNs, result.allocationsPerOp, static_cast<long long>(result.peakBytes),
+                   result.mediumOpsPerOp, result.simulatedMicrosPerOp);
+        else
+            printf("%-34s %7zu %6zu %14.0f %14.0f %12.1f %12lld %12.1f %12.0f\n", result.operation, result.configurations, result.parameters,
+                   result.medianNs, result.meanNs, result.allocationsPerOp, static_cast<long long>(result.peakBytes),
+                   result.mediumOpsPerOp, result.simulatedMicrosPerOp);
+        fflush(stdout);
+    }
+};
+
+#endif // __H_BENCHMARK_RUNNER__
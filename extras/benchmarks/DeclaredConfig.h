@@ -0,0 +1,48 @@
+#ifndef __H_DECLARED_CONFIG__
+#define __H_DECLARED_CONFIG__
+#include <config-handler-core.h>
+
+/**
+ * @brief A typical device configuration, declared with `ConfigurationFields` instead of hand-written `ConfigurationFunctions`.
+ *
+ */
+struct DeclaredConfig
+{
+    String ssid = "device";
+    String password;
+    String hostname = "device.local";
+    uint16_t port = 1883;
+    int32_t publishIntervalMs = 5000;
+    float temperatureOffset = 0;
+    double latitude = 0;
+    bool dhcp = true;
+};
+
+template <>
+struct ConfigurationFields<DeclaredConfig>
+{
+    static constexpr const char *title = "Declared config";
+    static constexpr const char *fileName = "/declared.conf";
+
+    static auto fields()
+    {
+        return std::make_tuple(configurationField(&DeclaredConfig::ssid, stringParameter("ssid", ParameterAttribute::ATTR_NONE, 32)),
+                               configurationField(&DeclaredConfig::password, stringParameter("password", ParameterAttribute::ATTR_PASSWORD, 64)),
+                               configurationField(&DeclaredConfig::hostname, stringParameter("hostname", ParameterAttribute::ATTR_NONE, 64)),
+                               configurationField(&DeclaredConfig::port, numericParameter("port", ParameterAttribute::ATTR_NONE, 1, 65535)),
+                               configurationField(&DeclaredConfig::publishIntervalMs, numericParameter("publishIntervalMs", ParameterAttribute::ATTR_NONE, 100, 3600000)),
+                               configurationField(&DeclaredConfig::temperatureOffset, floatParameter("temperatureOffset", ParameterAttribute::ATTR_NONE, -10, 10)),
+                               configurationField(&DeclaredConfig::latitude, "latitude"),
+                               configurationField(&DeclaredConfig::dhcp, "dhcp"));
+    }
+
+    static const ValidationResult validate(const DeclaredConfig &configuration)
+    {
+        if (!configuration.dhcp && configuration.hostname.isEmpty())
+            return ValidationResult::Failure("hostname: required when DHCP is off");
+        return ValidationResult::Success();
+    }
+};
+CONFIGURATION_FUNCTIONS_FROM_FIELDS(DeclaredConfig);
+
+#endif // __H_DECLARED_CONFIG__
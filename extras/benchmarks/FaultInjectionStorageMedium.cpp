@@ -0,0 +1,43 @@
+#include "FaultInjectionStorageMedium.h"
+
+void FaultInjectionStorageMedium::cutPowerAt(const uint32_t writeIndex)
+{
+    cutAt = writeIndex;
+    writeCount = 0;
+}
+
+bool FaultInjectionStorageMedium::openFile(const String &fileName, const FileMode fileMode)
+{
+    if (fileMode == FileMode::WRITE)
+        beginWrite();
+    return StorageMediumDecorator::openFile(fileName, fileMode);
+}
+
+bool FaultInjectionStorageMedium::deleteImpl(const String &fileName)
+{
+    beginWrite();
+    return StorageMediumDecorator::deleteImpl(fileName);
+}
+
+bool FaultInjectionStorageMedium::writeBlobImpl(const String &fileName, const std::vector<uint8_t> &data)
+{
+    if (writeCount == cutAt)
+    {
+        // The power goes out halfway through the blob.
+        StorageMediumDecorator::writeBlobImpl(fileName, std::vector<uint8_t>(data.begin(), data.begin() + data.size() / 2));
+    }
+    beginWrite();
+    return StorageMediumDecorator::writeBlobImpl(fileName, data);
+}
+
+bool FaultInjectionStorageMedium::deleteBlobImpl(const String &fileName)
+{
+    beginWrite();
+    return StorageMediumDecorator::deleteBlobImpl(fileName);
+}
+
+void FaultInjectionStorageMedium::beginWrite()
+{
+    if (writeCount++ >= cutAt)
+        throw PowerCut();
+}
@@ -0,0 +1,83 @@
+#ifndef __H_FAULT_INJECTION_STORAGE_MEDIUM__
+#define __H_FAULT_INJECTION_STORAGE_MEDIUM__
+#include <WString.h>
+#include <stdexcept>
+#include <stdint.h>
+#include <vector>
+#include <StorageMediumDecorator.h>
+
+/**
+ * @brief A storage medium that forwards every operation to another medium, and simulates a power cut at a chosen write.
+ *
+ * Every operation that changes the medium counts as one write: writing a key (batches count each of their keys),
+ * opening a file with `FileMode::WRITE` (it clears the file), writing a blob, and deleting a file or a blob.
+ * When the power is cut at write `n`, writes `0..n-1` are performed, and write `n` and every write after it throw `PowerCut` without reaching the medium,
+ * except that a blob write that is cut stores the first half of the blob (a torn write, the worst case for mediums that do not write blobs atomically).
+ * Example: save with every cut index up to `getWriteCount()` of an uninterrupted save, and check what is loaded after each one.
+ *
+ */
+class FaultInjectionStorageMedium : public StorageMediumDecorator
+{
+public:
+    /**
+     * @brief Thrown by the writes that happen after the power was cut.
+     */
+    class PowerCut : public std::runtime_error
+    {
+    public:
+        PowerCut() : std::runtime_error("Power cut!") {}
+    };
+
+    static constexpr uint32_t NEVER = UINT32_MAX;
+
+    FaultInjectionStorageMedium(StorageMedium &inner) : StorageMediumDecorator(inner), cutAt(NEVER), writeCount(0) {}
+
+    /**
+     * @brief Cuts the power at the write with the given index (counted since the last call), `NEVER` to keep it on.
+     */
+    void cutPowerAt(const uint32_t writeIndex);
+
+    /**
+     * @brief The number of writes attempted since the last call to `cutPowerAt`, including the ones that were cut.
+     */
+    uint32_t getWriteCount() const { return writeCount; }
+
+    bool isPowerCut() const { return writeCount > cutAt; }
+
+protected:
+    bool openFile(const String &fileName, const FileMode fileMode) override;
+
+    bool deleteImpl(const String &fileName) override;
+
+    bool writeBlobImpl(const String &fileName, const std::vector<uint8_t> &data) override;
+    bool deleteBlobImpl(const String &fileName) override;
+
+#pragma region Write functions
+    void writeChar(const String &key, const int8_t value) override { beginWrite(); StorageMediumDecorator::writeChar(key, value); }
+    void writeUChar(const String &key, const uint8_t value) override { beginWrite(); StorageMediumDecorator::writeUChar(key, value); }
+    void writeShort(const String &key, const int16_t value) override { beginWrite(); StorageMediumDecorator::writeShort(key, value); }
+    void writeUShort(const String &key, const uint16_t value) override { beginWrite(); StorageMediumDecorator::writeUShort(key, value); }
+    void writeInt(const String &key, const int32_t value) override { beginWrite(); StorageMediumDecorator::writeInt(key, value); }
+    void writeUInt(const String &key, const uint32_t value) override { beginWrite(); StorageMediumDecorator::writeUInt(key, value); }
+    void writeLong(const String &key, const int64_t value) override { beginWrite(); StorageMediumDecorator::writeLong(key, value); }
+    void writeULong(const String &key, const uint64_t value) override { beginWrite(); StorageMediumDecorator::writeULong(key, value); }
+    void writeFloat(const String &key, const float value) override { beginWrite(); StorageMediumDecorator::writeFloat(key, value); }
+    void writeDouble(const String &key, const double value) override { beginWrite(); StorageMediumDecorator::writeDouble(key, value); }
+    void writeBool(const String &key, const bool value) override { beginWrite(); StorageMediumDecorator::writeBool(key, value); }
+    void writeString(const String &key, const String value) override { beginWrite(); StorageMediumDecorator::writeString(key, value); }
+#pragma endregion
+
+    // Written key by key, so the power can be cut in the middle of a batch.
+    void writeBatch(const BatchEntry *entries, const size_t count) override { StorageMedium::writeBatch(entries, count); }
+
+private:
+    uint32_t cutAt;
+    uint32_t writeCount;
+
+    /**
+     * @brief Counts a write, and throws `PowerCut` if it must not happen.
+     */
+    void beginWrite();
+};
+
+#endif // __H_FAULT_INJECTION_STORAGE_MEDIUM__
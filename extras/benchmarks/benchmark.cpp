@@ -0,0 +1,603 @@
+#include <map>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <utility>
+#include <config-handler-core.h>
+#include <internal/string-utils.h>
+#include "BenchConfig.h"
+#include "DeclaredConfig.h"
+#include "BenchmarkRunner.h"
+#include "FaultInjectionStorageMedium.h"
+
+namespace
+{
+    /**
+     * @brief Input interface that edits every parameter once per session, validating after each edit, and then submits, standing in for a user.
+     *
+     */
+    class ScriptedInputInterface : public InputInterface
+    {
+    public:
+        /// @brief Changes with every session so that each one actually modifies the values.
+        unsigned int variant = 0;
+
+    protected:
+        void init(const ConfigInfo &configInfo, const std::map<String, String> &currentValues) override
+        {
+            init(configInfo, getParametersManger().getParametersView(configInfo.title));
+        }
+
+        void init(const ConfigInfo &configInfo, const ParameterValuesView &currentValues) override
+        {
+            std::vector<String> names;
+            names.reserve(configInfo.parameters.size());
+            for (const ParameterInfo &param : configInfo.parameters)
+                names.push_back(param.name);
+            categories.emplace_back(configInfo.title, std::move(names));
+        }
+
+        void startImpl() override { variant++; }
+
+        void update() override
+        {
+            ParametersManager &manager = getParametersManger();
+            // Validate after every field, like a form that checks the input as it is typed.
+            for (const auto &[category, names] : categories)
+            {
+                for (size_t i = 0; i < names.size(); i++)
+                {
+                    manager.setParameterValue(category, names[i], benchParameterValue(i, variant));
+                    if (validateInput().isFailure())
+                    {
+                        cancelSession();
+                        return;
+                    }
+                }
+            }
+        }
+
+        void cleanup() override { categories.clear(); }
+
+    private:
+        std::vector<std::pair<String, std::vector<String>>> categories;
+    };
+
+    /**
+     * @brief Rough cost of an NVS partition on an ESP32, only accounted for (the benchmark does not wait for it).
+     */
+    MemoryStorageMedium::LatencyModel flashLatency()
+    {
+        MemoryStorageMedium::LatencyModel latency;
+        latency.openMicros = 60;
+        latency.readMicros = 25;
+        latency.writeMicrosPerByte = 2;
+        return latency;
+    }
+
+    template <typename ConfigurationType>
+    void addParameters(ParametersManager &manager, unsigned int variant, bool modify = true)
+    {
+        const ConfigInfo &info = ConfigurationSchema<ConfigurationType>::getInfo();
+        for (size_t i = 0; i < info.parameters.size(); i++)
+        {
+            manager.addParameter(info.title, info.parameters[i], benchParameterValue(i, variant), ConfigurationFunctions<ConfigurationType>::getOptionsFor);
+            // Modify every value so validation and saving see a full edit.
+            if (modify)
+                manager.setParameterValue(info.title, info.parameters[i].name, benchParameterValue(i, variant + 1));
+        }
+    }
+
+    template <size_t ParameterCount, size_t... Indices>
+    void runSweep(BenchmarkRunner &runner, std::index_sequence<Indices...>)
+    {
+        constexpr size_t configCount = sizeof...(Indices);
+        MemoryStorageMedium medium(flashLatency(), MemoryStorageMedium::WearModel());
+        ConfigurationHandler handler(medium);
+        ConfigurationHandler manifestHandler(medium, StorageEncoding::KEYS, SaveMode::DIRECT, ConfigurationIndex::MANIFEST);
+
+        ParametersManager manager;
+        (addParameters<BenchConfig<Indices, ParameterCount>>(manager, 0), ...);
+        // Make sure every configuration exists (and is in the manifest) before measuring the read paths.
+        manifestHandler.saveConfiguration<BenchConfig<Indices, ParameterCount>...>(manager);
+
+        runner.run("configsAreComplete", configCount, ParameterCount, &medium, [&]()
+                   { handler.configsAreComplete<BenchConfig<Indices, ParameterCount>...>(); });
+        runner.run("configsAreComplete(manifest)", configCount, ParameterCount, &medium, [&]()
+                   { manifestHandler.configsAreComplete<BenchConfig<Indices, ParameterCount>...>(); });
+        runner.run("loadConfigurations", configCount, ParameterCount, &medium, [&]()
+                   { handler.loadConfigurations<BenchConfig<Indices, ParameterCount>...>(); });
+        // The checks a sketch makes at boot, through a cache that starts empty.
+        const auto boot = [](ConfigurationHandler &bootHandler)
+        {
+            if (bootHandler.configsExist<BenchConfig<Indices, ParameterCount>...>() && bootHandler.configsAreComplete<BenchConfig<Indices, ParameterCount>...>())
+            {
+                bootHandler.loadConfigurations<BenchConfig<Indices, ParameterCount>...>();
+                bootHandler.validateConfigurations<BenchConfig<Indices, ParameterCount>...>(ChainedValidationResults::FAIL_FAST);
+            }
+        };
+        runner.run("bootSequence", configCount, ParameterCount, &medium, [&]()
+                   { boot(handler); });
+        runner.run("bootSequence(cached)", configCount, ParameterCount, &medium, [&]()
+                   {
+            // Room for every value and the existence and completeness of every file.
+            CachingStorageMedium cache(medium, configCount * (ParameterCount + 2) * 320);
+            ConfigurationHandler cachedHandler(cache);
+            boot(cachedHandler); });
+        runner.run("bootSequence(manifest)", configCount, ParameterCount, &medium, [&]()
+                   { boot(manifestHandler); });
+        runner.run("bootSequence(fingerprint)", configCount, ParameterCount, &medium, [&]()
+                   {
+            std::tuple<std::optional<BenchConfig<Indices, ParameterCount>>...> configurations;
+            manifestHandler.checkBoot(configurations); });
+        runner.run("validateAllValues", configCount, ParameterCount, nullptr, [&]()
+                   { manager.validateAllValues(); });
+        const String lastCategory = ConfigurationSchema<BenchConfig<configCount - 1, ParameterCount>>::getInfo().title;
+        const String lastParameter = benchParameterName(ParameterCount - 1);
+        const String editedValue = benchParameterValue(ParameterCount - 1, 7);
+        runner.run("setParameterValue(name)", configCount, ParameterCount, nullptr, [&]()
+                   { manager.setParameterValue(lastCategory, lastParameter, editedValue); });
+        const ParametersManager::ParameterHandle lastHandle = manager.getHandle(lastCategory, lastParameter);
+        runner.run("setParameterValue(handle)", configCount, ParameterCount, nullptr, [&]()
+                   { manager.setParameterValue(lastHandle, editedValue); });
+        runner.run("saveConfiguration", configCount, ParameterCount, &medium, [&]()
+                   { handler.saveConfiguration<BenchConfig<Indices, ParameterCount>...>(manager); });
+        ConfigurationHandler journaledHandler(medium, StorageEncoding::KEYS, SaveMode::JOURNALED);
+        runner.run("saveConfiguration(journaled)", configCount, ParameterCount, &medium, [&]()
+                   { journaledHandler.saveConfiguration<BenchConfig<Indices, ParameterCount>...>(manager); });
+
+        // A typical settings edit: a single field of a single configuration.
+        ParametersManager singleEdit;
+        (addParameters<BenchConfig<Indices, ParameterCount>>(singleEdit, 0, false), ...);
+        singleEdit.setParameterValue(lastCategory, lastParameter, editedValue);
+        runner.run("saveConfiguration(1 edit)", configCount, ParameterCount, &medium, [&]()
+                   { handler.saveConfiguration<BenchConfig<Indices, ParameterCount>...>(singleEdit); });
+
+        ScriptedInputInterface inputInterface;
+        runner.run("inputSession", configCount, ParameterCount, &medium, [&]()
+                   { handler.startInputInterface<BenchConfig<Indices, ParameterCount>...>(inputInterface); });
+
+        runner.run("validateConfigurations", configCount, ParameterCount, &medium, [&]()
+                   { handler.validateConfigurations<BenchConfig<Indices, ParameterCount>...>(); });
+        // Store a string that is too long in the first configuration, a boot-time check only needs to find it.
+        {
+            StorageMedium::FileHandler fileHandler = handler.createFileHandler<BenchConfig<0, ParameterCount>>(FileMode::UPDATE);
+            String tooLong;
+            for (size_t i = 0; i < 100; i++)
+                tooLong += 'x';
+            fileHandler.write<String>(benchParameterName(3), tooLong);
+        }
+        runner.run("validateConfigurations(invalid)", configCount, ParameterCount, &medium, [&]()
+                   { handler.validateConfigurations<BenchConfig<Indices, ParameterCount>...>(); });
+        runner.run("validateConfigurations(fail-fast)", configCount, ParameterCount, &medium, [&]()
+                   { handler.validateConfigurations<BenchConfig<Indices, ParameterCount>...>(ChainedValidationResults::FAIL_FAST); });
+    }
+
+    template <size_t ParameterCount>
+    void runSweeps(BenchmarkRunner &runner)
+    {
+        runSweep<ParameterCount>(runner, std::make_index_sequence<1>());
+        runSweep<ParameterCount>(runner, std::make_index_sequence<4>());
+        runSweep<ParameterCount>(runner, std::make_index_sequence<16>());
+    }
+
+    /**
+     * @brief The cost of creating and calling the built-in validators, and of validating an option set parameter with many options (e.g. timezones).
+     */
+    void runValidatorBenchmarks(BenchmarkRunner &runner)
+    {
+        runner.run("createParameter(numeric)", 1, 1, nullptr, [&]()
+                   { numericParameter("mqttBrokerPort", ParameterAttribute::ATTR_NONE, 1, 65535); });
+        const ParameterInfo port = numericParameter("mqttBrokerPort", ParameterAttribute::ATTR_NONE, 1, 65535);
+        const String portValue = "1883";
+        runner.run("validateNumeric", 1, 1, nullptr, [&]()
+                   {
+            if (port.isValid(port.name, portValue).isFailure())
+                abort(); });
+
+        constexpr size_t optionsCount = 400;
+        const ParameterInfo parameter = optionSetParameter("timezone", ParameterAttribute::ATTR_NONE, []()
+                                                           {
+            std::vector<String> options;
+            options.reserve(optionsCount);
+            for (size_t i = 0; i < optionsCount; i++)
+                options.push_back(String("Region/City_") + static_cast<unsigned int>(i));
+            return options; });
+        // The options are cached by the session (the parameters manager), not by the parameter.
+        ParametersManager session;
+        const ParametersManager::ParameterHandle handle = session.addParameter("Time", parameter, "", nullptr);
+        const String value = String("Region/City_") + static_cast<unsigned int>(optionsCount - 1);
+        runner.run("validateOptionSet", 1, optionsCount, nullptr, [&]()
+                   {
+            if (session.validateValue(handle, value).isFailure())
+                abort(); });
+
+        // A boot-time check only asks whether the value is valid, the error message is never rendered.
+        const String invalidValue = "Region/Nowhere";
+        runner.run("validateOptionSet(invalid)", 1, optionsCount, nullptr, [&]()
+                   {
+            if (session.validateValue(handle, invalidValue).isSuccess())
+                abort(); });
+    }
+
+    /**
+     * @brief A configuration declared with `ConfigurationFields`: objects are read field by field, and saving uses the parsed values.
+     */
+    void runDeclaredBenchmarks(BenchmarkRunner &runner)
+    {
+        MemoryStorageMedium medium(flashLatency(), MemoryStorageMedium::WearModel());
+        ConfigurationHandler handler(medium);
+        std::map<String, String> values;
+        {
+            StorageMedium::FileHandler fileHandler = handler.createFileHandler<DeclaredConfig>(FileMode::WRITE);
+            ConfigurationFunctions<DeclaredConfig>::saveObject(DeclaredConfig(), fileHandler);
+        }
+        {
+            StorageMedium::FileHandler fileHandler = handler.createFileHandler<DeclaredConfig>(FileMode::READ);
+            values = ConfigurationFunctions<DeclaredConfig>::loadAsMap(fileHandler);
+        }
+        const ConfigInfo &info = ConfigurationSchema<DeclaredConfig>::getInfo();
+        const size_t parameterCount = info.parameters.size();
+
+        runner.run("loadConfiguration(declared)", 1, parameterCount, &medium, [&]()
+                   {
+            if (!handler.loadConfiguration<DeclaredConfig>())
+                abort(); });
+        runner.run("validateConfigurations(declared)", 1, parameterCount, &medium, [&]()
+                   { handler.validateConfigurations<DeclaredConfig>(); });
+
+        ParametersManager manager;
+        for (const ParameterInfo &parameter : info.parameters)
+            manager.addParameter(info.title, parameter, values[parameter.name], ConfigurationFunctions<DeclaredConfig>::getOptionsFor);
+        manager.setParameterValue(info.title, "port", "8883");
+        runner.run("saveConfiguration(declared)", 1, parameterCount, &medium, [&]()
+                   { handler.saveConfiguration<DeclaredConfig>(manager); });
+
+        // The same configuration stored as one packed blob, on its own medium (writing the blob deletes the keys).
+        MemoryStorageMedium packedMedium(flashLatency(), MemoryStorageMedium::WearModel());
+        ConfigurationHandler packedHandler(packedMedium, StorageEncoding::PACKED);
+        packedHandler.saveConfiguration<DeclaredConfig>(manager);
+        runner.run("loadConfiguration(declared,packed)", 1, parameterCount, &packedMedium, [&]()
+                   {
+            if (!packedHandler.loadConfiguration<DeclaredConfig>())
+                abort(); });
+        runner.run("saveConfiguration(declared,packed)", 1, parameterCount, &packedMedium, [&]()
+                   { packedHandler.saveConfiguration<DeclaredConfig>(manager); });
+
+        // A runtime hot path that reads two values: through the medium, and from a memory-mapped snapshot.
+        static volatile size_t sink;
+        const String ssid = "ssid";
+        const String port = "port";
+        runner.run("readValues(declared)", 1, 2, &medium, [&]()
+                   {
+            StorageMedium::FileHandler fileHandler = handler.createFileHandler<DeclaredConfig>(FileMode::READ);
+            sink = fileHandler.read<String>(ssid).length() + fileHandler.read<uint16_t>(port); });
+#ifdef CONFIG_HANDLER_MAP_FILES
+        char path[] = "/tmp/config-handler-snapshot-XXXXXX";
+        const int fd = mkstemp(path);
+        if (fd < 0 || !MappedRegion::storeFile(path, ConfigurationSnapshot<DeclaredConfig>::pack(DeclaredConfig())))
+            abort();
+        close(fd);
+        {
+            const ConfigurationSnapshot<DeclaredConfig> snapshot(MappedRegion::mapFile(path));
+            if (!snapshot)
+                abort();
+            runner.run("readValues(declared,snapshot)", 1, 2, nullptr, [&]()
+                       { sink = snapshot.get(&DeclaredConfig::ssid).size() + snapshot.get(&DeclaredConfig::port); });
+        }
+        unlink(path);
+#endif
+    }
+
+    /**
+     * @brief Runtime code that updates two counters ten times, each update through its own file handler,
+     * written straight to the medium, and buffered by a `WriteBackStorageMedium` that is flushed once.
+     */
+    void runWriteBackBenchmarks(BenchmarkRunner &runner)
+    {
+        constexpr size_t updates = 10;
+        MemoryStorageMedium medium(flashLatency(), MemoryStorageMedium::WearModel());
+        const String fileName = "/counters";
+        const String packets = "packets";
+        const String uptime = "uptimeSeconds";
+        const auto update = [&](StorageMedium &target)
+        {
+            for (uint32_t i = 0; i < updates; i++)
+            {
+                StorageMedium::FileHandler fileHandler = target.createFileHandler(fileName, FileMode::UPDATE);
+                fileHandler.write<uint32_t>(packets, i * 3);
+                fileHandler.write<uint32_t>(uptime, i);
+            }
+        };
+        runner.run("updateCounters(write-through)", 1, updates, &medium, [&]()
+                   { update(medium); });
+        WriteBackStorageMedium writeBack(medium);
+        runner.run("updateCounters(write-back)", 1, updates, &medium, [&]()
+                   {
+            update(writeBack);
+            writeBack.flush(); });
+    }
+
+    /**
+     * @brief The numeric parsers of string-utils against the C library's `strtol`/`strtod` family, over a mix of typical values.
+     * Each operation parses every input once.
+     */
+    void runParserBenchmarks(BenchmarkRunner &runner)
+    {
+        static const char *const integers[] = {"0", "42", "-17", "1883", "65535", "-2147483648", "2147483647", "123456789"};
+        static const char *const decimals[] = {"0", "1.5", "-3.25", "3.14159", "0.001", "-273.15", "6.02214076e23", "1e-7"};
+        constexpr size_t count = sizeof(integers) / sizeof(integers[0]);
+        size_t lengths[count];
+        size_t decimalLengths[count];
+        for (size_t i = 0; i < count; i++)
+        {
+            lengths[i] = strlen(integers[i]);
+            decimalLengths[i] = strlen(decimals[i]);
+        }
+        // Keeps the compiler from dropping the parsing.
+        static volatile int64_t integerSink;
+        static volatile double decimalSink;
+
+        runner.run("parse int32 (tryParseInt32)", 1, count, nullptr, [&]()
+                   {
+            for (size_t i = 0; i < count; i++)
+            {
+                int32_t value;
+                tryParseInt32(integers[i], lengths[i], &value);
+                integerSink = value;
+            } });
+        runner.run("parse int32 (strtol)", 1, count, nullptr, [&]()
+                   {
+            for (size_t i = 0; i < count; i++)
+                integerSink = strtol(integers[i], nullptr, 10); });
+        runner.run("parse int64 (tryParseInt64)", 1, count, nullptr, [&]()
+                   {
+            for (size_t i = 0; i < count; i++)
+            {
+                int64_t value;
+                tryParseInt64(integers[i], lengths[i], &value);
+                integerSink = value;
+            } });
+        runner.run("parse int64 (strtoll)", 1, count, nullptr, [&]()
+                   {
+            for (size_t i = 0; i < count; i++)
+                integerSink = strtoll(integers[i], nullptr, 10); });
+        runner.run("parse float (tryParseFloat)", 1, count, nullptr, [&]()
+                   {
+            for (size_t i = 0; i < count; i++)
+            {
+                float value;
+                tryParseFloat(decimals[i], decimalLengths[i], &value);
+                decimalSink = value;
+            } });
+        runner.run("parse float (strtof)", 1, count, nullptr, [&]()
+                   {
+            for (size_t i = 0; i < count; i++)
+                decimalSink = strtof(decimals[i], nullptr); });
+        runner.run("parse double (tryParseDouble)", 1, count, nullptr, [&]()
+                   {
+            for (size_t i = 0; i < count; i++)
+            {
+                double value;
+                tryParseDouble(decimals[i], decimalLengths[i], &value);
+                decimalSink = value;
+            } });
+        runner.run("parse double (strtod)", 1, count, nullptr, [&]()
+                   {
+            for (size_t i = 0; i < count; i++)
+                decimalSink = strtod(decimals[i], nullptr); });
+    }
+
+    void addDeclaredParameters(ParametersManager &manager, const char *port)
+    {
+        const ConfigInfo &info = ConfigurationSchema<DeclaredConfig>::getInfo();
+        std::map<String, String> values = ConfigurationFunctions<DeclaredConfig>::toMap(DeclaredConfig());
+        for (const ParameterInfo &parameter : info.parameters)
+            manager.addParameter(info.title, parameter, values[parameter.name], ConfigurationFunctions<DeclaredConfig>::getOptionsFor);
+        if (port != nullptr)
+            manager.setParameterValue(info.title, "port", port);
+    }
+
+    /**
+     * @brief The stored values of a configuration, as one string.
+     */
+    template <typename ConfigurationType>
+    String storedValues(ConfigurationHandler &handler)
+    {
+        std::map<String, String> values;
+        if constexpr (IsPackable<ConfigurationType>::value)
+        {
+            const std::optional<ConfigurationType> configuration = handler.loadConfiguration<ConfigurationType>();
+            if (configuration)
+                values = ConfigurationFunctions<ConfigurationType>::toMap(*configuration);
+        }
+        else
+        {
+            const StorageMedium::FileHandler fileHandler = handler.createFileHandler<ConfigurationType>(FileMode::READ);
+            if (fileHandler)
+                values = ConfigurationFunctions<ConfigurationType>::loadAsMap(fileHandler);
+        }
+        String result;
+        for (const auto &[name, value] : values)
+            result += name + "=" + value + ";";
+        return result;
+    }
+
+    typedef BenchConfig<0, 16> FirstSweepConfig;
+    typedef BenchConfig<1, 16> SecondSweepConfig;
+
+    /**
+     * @brief The save of the power-cut sweeps: every value of the first configuration is edited (the file is rewritten), and a single value of the other two.
+     *
+     * @param edit false for the save that stores the old values.
+     */
+    void saveSweepConfigurations(ConfigurationHandler &handler, const bool edit)
+    {
+        ParametersManager manager;
+        addParameters<FirstSweepConfig>(manager, 0, edit);
+        addParameters<SecondSweepConfig>(manager, 0, false);
+        addDeclaredParameters(manager, edit ? "8883" : nullptr);
+        if (edit)
+            manager.setParameterValue(ConfigurationSchema<SecondSweepConfig>::getInfo().title, benchParameterName(3), "edited");
+        handler.saveConfiguration<FirstSweepConfig, SecondSweepConfig, DeclaredConfig>(manager);
+    }
+
+    /**
+     * @brief Saves three configurations (two in keys, one packed) with the power cut at every write in turn,
+     * and checks what is loaded after the reboot: all the configurations must be either old or new.
+     *
+     * @return The number of cut points that left some configurations old and others new (or half-written).
+     */
+    size_t runPowerCutSweep(const SaveMode saveMode)
+    {
+        const auto state = [](ConfigurationHandler &handler)
+        { return storedValues<FirstSweepConfig>(handler) + "|" + storedValues<SecondSweepConfig>(handler) + "|" + storedValues<DeclaredConfig>(handler); };
+
+        // Runs the save with the power cut at `cut`, and returns what is loaded after the reboot.
+        const auto run = [&](const uint32_t cut, String *oldState, uint32_t *writeCount)
+        {
+            MemoryStorageMedium medium;
+            ConfigurationHandler setup(medium, StorageEncoding::PACKED);
+            saveSweepConfigurations(setup, false);
+            if (oldState != nullptr)
+                *oldState = state(setup);
+
+            FaultInjectionStorageMedium faulty(medium);
+            ConfigurationHandler handler(faulty, StorageEncoding::PACKED, saveMode);
+            faulty.cutPowerAt(cut);
+            try
+            {
+                saveSweepConfigurations(handler, true);
+            }
+            catch (const FaultInjectionStorageMedium::PowerCut &)
+            {
+            }
+            if (writeCount != nullptr)
+                *writeCount = faulty.getWriteCount();
+
+            ConfigurationHandler rebooted(medium, StorageEncoding::PACKED, saveMode);
+            rebooted.recoverJournal();
+            return state(rebooted);
+        };
+
+        String oldState;
+        uint32_t writeCount;
+        const String newState = run(FaultInjectionStorageMedium::NEVER, &oldState, &writeCount);
+        size_t oldCount = 0;
+        size_t newCount = 0;
+        size_t inconsistentCount = 0;
+        for (uint32_t cut = 0; cut < writeCount; cut++)
+        {
+            const String rebootedState = run(cut, nullptr, nullptr);
+            if (rebootedState == oldState)
+                oldCount++;
+            else if (rebootedState == newState)
+                newCount++;
+            else
+                inconsistentCount++;
+        }
+        printf("power-cut sweep (%s): %lu writes, %lu cut points left the old values, %lu the new values, %lu a mix\n",
+               saveMode == SaveMode::JOURNALED ? "journaled" : "direct", static_cast<unsigned long>(writeCount),
+               static_cast<unsigned long>(oldCount), static_cast<unsigned long>(newCount), static_cast<unsigned long>(inconsistentCount));
+        return inconsistentCount;
+    }
+
+    /**
+     * @brief Saves the same configurations directly, with a manifest, with the power cut at every write in turn,
+     * and checks after the reboot that the manifest does not report a configuration as complete while its file is not.
+     *
+     * @return The number of cut points after which the manifest reported an incomplete configuration as complete.
+     */
+    size_t runManifestPowerCutSweep()
+    {
+        const auto run = [](const uint32_t cut, uint32_t *writeCount)
+        {
+            MemoryStorageMedium medium;
+            ConfigurationHandler setup(medium, StorageEncoding::KEYS, SaveMode::DIRECT, ConfigurationIndex::MANIFEST);
+            saveSweepConfigurations(setup, false);
+
+            FaultInjectionStorageMedium faulty(medium);
+            ConfigurationHandler handler(faulty, StorageEncoding::KEYS, SaveMode::DIRECT, ConfigurationIndex::MANIFEST);
+            faulty.cutPowerAt(cut);
+            try
+            {
+                saveSweepConfigurations(handler, true);
+            }
+            catch (const FaultInjectionStorageMedium::PowerCut &)
+            {
+            }
+            if (writeCount != nullptr)
+                *writeCount = faulty.getWriteCount();
+
+            ConfigurationHandler indexed(medium, StorageEncoding::KEYS, SaveMode::DIRECT, ConfigurationIndex::MANIFEST);
+            ConfigurationHandler probed(medium);
+            const auto misreported = [&](auto configuration)
+            {
+                typedef decltype(configuration) ConfigurationType;
+                return indexed.configsAreComplete<ConfigurationType>() && !probed.configsAreComplete<ConfigurationType>();
+            };
+            return misreported(FirstSweepConfig()) || misreported(SecondSweepConfig()) || misreported(DeclaredConfig());
+        };
+
+        uint32_t writeCount;
+        run(FaultInjectionStorageMedium::NEVER, &writeCount);
+        size_t misreportedCount = 0;
+        for (uint32_t cut = 0; cut < writeCount; cut++)
+            misreportedCount += run(cut, nullptr) ? 1 : 0;
+        printf("power-cut sweep (direct, manifest): %lu writes, %lu cut points left an incomplete configuration recorded as complete\n",
+               static_cast<unsigned long>(writeCount), static_cast<unsigned long>(misreportedCount));
+        return misreportedCount;
+    }
+
+    void printUsage(const char *program)
+    {
+        printf("Usage: %s [--iterations=N] [--filter=SUBSTRING] [--csv]\n", program);
+    }
+}
+
+int main(int argc, char **argv)
+{
+    size_t iterations = 200;
+    bool csv = false;
+    const char *filter = nullptr;
+    for (int i = 1; i < argc; i++)
+    {
+        if (strncmp(argv[i], "--iterations=", 13) == 0)
+            iterations = strtoul(argv[i] + 13, nullptr, 10);
+        else if (strncmp(argv[i], "--filter=", 9) == 0)
+            filter = argv[i] + 9;
+        else if (strcmp(argv[i], "--csv") == 0)
+            csv = true;
+        else
+        {
+            printUsage(argv[0]);
+            return strcmp(argv[i], "--help") == 0 ? 0 : 1;
+        }
+    }
+    if (iterations == 0)
+        iterations = 1;
+
+    BenchmarkRunner runner(iterations, csv, filter);
+    runner.printHeader();
+    runSweeps<4>(runner);
+    runSweeps<16>(runner);
+    runSweeps<32>(runner);
+    runDeclaredBenchmarks(runner);
+    runWriteBackBenchmarks(runner);
+    runValidatorBenchmarks(runner);
+    runParserBenchmarks(runner);
+    // Memory rather than time: what each parameter of a schema costs.
+    if (!csv && (filter == nullptr || strstr("sizeof", filter) != nullptr))
+        printf("sizeof(ParameterInfo): %lu bytes, of which the Validator: %lu bytes (a std::function is %lu bytes)\n",
+               static_cast<unsigned long>(sizeof(ParameterInfo)), static_cast<unsigned long>(sizeof(Validator)),
+               static_cast<unsigned long>(sizeof(std::function<ValidationResult(const String &)>)));
+    // A correctness check rather than a measurement: the journaled save must never leave a mix of old and new values,
+    // and the manifest must never report a configuration that a direct save left half-written as complete.
+    if (!csv && (filter == nullptr || strstr("power-cut", filter) != nullptr))
+    {
+        runPowerCutSweep(SaveMode::DIRECT);
+        if (runPowerCutSweep(SaveMode::JOURNALED) != 0 || runManifestPowerCutSweep() != 0)
+            return 1;
+    }
+    return 0;
+}
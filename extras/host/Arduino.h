@@ -0,0 +1,21 @@
+#ifndef __H_HOST_ARDUINO__
+#define __H_HOST_ARDUINO__
+#include <stdint.h>
+#include "HardwareSerial.h"
+#include "Print.h"
+#include "WString.h"
+
+/**
+ * @brief Milliseconds elapsed since the program started (monotonic).
+ */
+unsigned long millis();
+
+/**
+ * @brief Microseconds elapsed since the program started (monotonic).
+ */
+unsigned long micros();
+
+void delay(unsigned long ms);
+void delayMicroseconds(unsigned int us);
+
+#endif // __H_HOST_ARDUINO__
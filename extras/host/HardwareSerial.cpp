@@ -0,0 +1,51 @@
+#include <stdio.h>
+#include <sys/ioctl.h>
+#include <unistd.h>
+#include "HardwareSerial.h"
+
+HardwareSerial Serial;
+
+int HardwareSerial::available()
+{
+    int pending = 0;
+    if (ioctl(STDIN_FILENO, FIONREAD, &pending) != 0)
+        return 0;
+    return pending;
+}
+
+int HardwareSerial::read()
+{
+    return getchar();
+}
+
+int HardwareSerial::peek()
+{
+    const int c = getchar();
+    if (c != EOF)
+        ungetc(c, stdin);
+    return c;
+}
+
+String HardwareSerial::readStringUntil(char terminator)
+{
+    String result;
+    int c;
+    while ((c = read()) != EOF && c != terminator)
+        result += static_cast<char>(c);
+    return result;
+}
+
+size_t HardwareSerial::write(uint8_t c)
+{
+    return fputc(c, stdout) == EOF ? 0 : 1;
+}
+
+size_t HardwareSerial::write(const uint8_t *buffer, size_t size)
+{
+    return fwrite(buffer, 1, size, stdout);
+}
+
+void HardwareSerial::flush()
+{
+    fflush(stdout);
+}
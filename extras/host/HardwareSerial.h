@@ -0,0 +1,36 @@
+#ifndef __H_HOST_HARDWARE_SERIAL__
+#define __H_HOST_HARDWARE_SERIAL__
+#include <stddef.h>
+#include <stdint.h>
+#include "Print.h"
+#include "WString.h"
+
+/**
+ * @brief Host stand-in for the Arduino `HardwareSerial` class.
+ *
+ * Output goes to `stdout` and input is read from `stdin`, so sketches and input interfaces can be driven from a terminal or a pipe.
+ *
+ */
+class HardwareSerial : public Print
+{
+public:
+    void begin(unsigned long baud) { (void)baud; }
+    void end() {}
+
+    int available();
+    int read();
+    int peek();
+    String readStringUntil(char terminator);
+
+    using Print::write;
+    size_t write(uint8_t c) override;
+    size_t write(const uint8_t *buffer, size_t size) override;
+
+    void flush() override;
+
+    operator bool() const { return true; }
+};
+
+extern HardwareSerial Serial;
+
+#endif // __H_HOST_HARDWARE_SERIAL__
@@ -0,0 +1,64 @@
+#include <stdarg.h>
+#include <stdio.h>
+#include <string.h>
+#include "Print.h"
+
+size_t Print::write(const uint8_t *buffer, size_t size)
+{
+    size_t n = 0;
+    while (size--)
+    {
+        if (!write(*buffer++))
+            break;
+        n++;
+    }
+    return n;
+}
+
+size_t Print::write(const char *str)
+{
+    return str ? write(reinterpret_cast<const uint8_t *>(str), strlen(str)) : 0;
+}
+
+size_t Print::printf(const char *format, ...)
+{
+    char stackBuffer[64];
+    va_list args;
+    va_start(args, format);
+    va_list argsCopy;
+    va_copy(argsCopy, args);
+    const int length = vsnprintf(stackBuffer, sizeof(stackBuffer), format, args);
+    va_end(args);
+    if (length < 0)
+    {
+        va_end(argsCopy);
+        return 0;
+    }
+
+    size_t written;
+    if (static_cast<size_t>(length) < sizeof(stackBuffer))
+        written = write(reinterpret_cast<const uint8_t *>(stackBuffer), length);
+    else
+    {
+        char *heapBuffer = new char[length + 1];
+        vsnprintf(heapBuffer, length + 1, format, argsCopy);
+        written = write(reinterpret_cast<const uint8_t *>(heapBuffer), length);
+        delete[] heapBuffer;
+    }
+    va_end(argsCopy);
+    return written;
+}
+
+size_t Print::print(const String &s) { return write(reinterpret_cast<const uint8_t *>(s.c_str()), s.length()); }
+size_t Print::print(const char *s) { return write(s); }
+size_t Print::print(char c) { return write(static_cast<uint8_t>(c)); }
+size_t Print::print(int n) { return printf("%d", n); }
+size_t Print::print(unsigned int n) { return printf("%u", n); }
+size_t Print::print(long n) { return printf("%ld", n); }
+size_t Print::print(unsigned long n) { return printf("%lu", n); }
+size_t Print::print(double n, int digits) { return printf("%.*f", digits, n); }
+
+size_t Print::println()
+{
+    return write('\n');
+}
@@ -0,0 +1,44 @@
+#ifndef __H_HOST_PRINT__
+#define __H_HOST_PRINT__
+#include <stddef.h>
+#include <stdint.h>
+#include "WString.h"
+
+/**
+ * @brief Host stand-in for the Arduino `Print` class, the base of every character output (`Serial`, network clients, displays, ...).
+ *
+ * Derived classes implement `write`; formatting is done here.
+ *
+ */
+class Print
+{
+public:
+    virtual ~Print() {}
+
+    virtual size_t write(uint8_t c) = 0;
+    virtual size_t write(const uint8_t *buffer, size_t size);
+    size_t write(const char *str);
+
+    size_t printf(const char *format, ...) __attribute__((format(printf, 2, 3)));
+
+    size_t print(const String &s);
+    size_t print(const char *s);
+    size_t print(char c);
+    size_t print(int n);
+    size_t print(unsigned int n);
+    size_t print(long n);
+    size_t print(unsigned long n);
+    size_t print(double n, int digits = 2);
+
+    size_t println();
+    template <typename T>
+    size_t println(const T &value)
+    {
+        const size_t n = print(value);
+        return n + println();
+    }
+
+    virtual void flush() {}
+};
+
+#endif // __H_HOST_PRINT__
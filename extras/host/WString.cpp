@@ -0,0 +1,562 @@
+#include <ctype.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "WString.h"
+
+namespace
+{
+    // Formats an integer in the given base into `buf` (which must hold at least 66 characters).
+    void formatUnsigned(unsigned long long value, unsigned char base, char *buf)
+    {
+        char tmp[66];
+        int i = 0;
+        if (base < 2 || base > 36)
+            base = 10;
+        do
+        {
+            const unsigned digit = value % base;
+            tmp[i++] = static_cast<char>(digit < 10 ? '0' + digit : 'a' + digit - 10);
+            value /= base;
+        } while (value != 0);
+        int j = 0;
+        while (i > 0)
+            buf[j++] = tmp[--i];
+        buf[j] = '\0';
+    }
+
+    void formatSigned(long long value, unsigned char base, char *buf)
+    {
+        if (value < 0 && base == 10)
+        {
+            buf[0] = '-';
+            formatUnsigned(0ULL - static_cast<unsigned long long>(value), base, buf + 1);
+        }
+        else
+            formatUnsigned(static_cast<unsigned long long>(value), base, buf);
+    }
+
+    void formatDouble(double value, unsigned int decimalPlaces, char *buf, size_t size)
+    {
+        snprintf(buf, size, "%.*f", static_cast<int>(decimalPlaces), value);
+    }
+}
+
+#pragma region Construction
+String::String(const char *cstr)
+{
+    init();
+    if (cstr)
+        copy(cstr, strlen(cstr));
+}
+
+String::String(const char *cstr, unsigned int length)
+{
+    init();
+    if (cstr)
+        copy(cstr, length);
+}
+
+String::String(const String &value)
+{
+    init();
+    *this = value;
+}
+
+String::String(String &&rval)
+{
+    init();
+    move(rval);
+}
+
+String::String(StringSumHelper &&rval)
+{
+    init();
+    move(rval);
+}
+
+String::String(char c)
+{
+    init();
+    char buf[2] = {c, '\0'};
+    *this = buf;
+}
+
+String::String(unsigned char value, unsigned char base)
+{
+    init();
+    char buf[66];
+    formatUnsigned(value, base, buf);
+    *this = buf;
+}
+
+String::String(int value, unsigned char base)
+{
+    init();
+    char buf[67];
+    formatSigned(value, base, buf);
+    *this = buf;
+}
+
+String::String(unsigned int value, unsigned char base)
+{
+    init();
+    char buf[66];
+    formatUnsigned(value, base, buf);
+    *this = buf;
+}
+
+String::String(long value, unsigned char base)
+{
+    init();
+    char buf[67];
+    formatSigned(value, base, buf);
+    *this = buf;
+}
+
+String::String(unsigned long value, unsigned char base)
+{
+    init();
+    char buf[66];
+    formatUnsigned(value, base, buf);
+    *this = buf;
+}
+
+String::String(long long value, unsigned char base)
+{
+    init();
+    char buf[67];
+    formatSigned(value, base, buf);
+    *this = buf;
+}
+
+String::String(unsigned long long value, unsigned char base)
+{
+    init();
+    char buf[66];
+    formatUnsigned(value, base, buf);
+    *this = buf;
+}
+
+String::String(float value, unsigned int decimalPlaces)
+{
+    init();
+    char buf[64];
+    formatDouble(value, decimalPlaces, buf, sizeof(buf));
+    *this = buf;
+}
+
+String::String(double value, unsigned int decimalPlaces)
+{
+    init();
+    char buf[64];
+    formatDouble(value, decimalPlaces, buf, sizeof(buf));
+    *this = buf;
+}
+
+String::~String()
+{
+    invalidate();
+}
+#pragma endregion
+
+#pragma region Memory management
+void String::init()
+{
+    heapBuffer = nullptr;
+    capacity = SSO_CAPACITY;
+    len = 0;
+    sso[0] = '\0';
+}
+
+void String::invalidate()
+{
+    free(heapBuffer);
+    init();
+}
+
+bool String::reserve(unsigned int size)
+{
+    if (size <= capacity)
+        return true;
+    return changeBuffer(size);
+}
+
+bool String::changeBuffer(unsigned int maxStrLen)
+{
+    if (maxStrLen <= SSO_CAPACITY && isSSO())
+        return true;
+
+    // Grow the heap buffer, moving the inline contents out on the first heap allocation.
+    char *newBuffer = static_cast<char *>(realloc(heapBuffer, maxStrLen + 1));
+    if (!newBuffer)
+        return false;
+    if (isSSO())
+        memcpy(newBuffer, sso, len + 1);
+    heapBuffer = newBuffer;
+    capacity = maxStrLen;
+    return true;
+}
+
+String &String::copy(const char *cstr, unsigned int length)
+{
+    if (!reserve(length))
+    {
+        invalidate();
+        return *this;
+    }
+    len = length;
+    memmove(buffer(), cstr, length);
+    buffer()[len] = '\0';
+    return *this;
+}
+
+void String::move(String &rhs)
+{
+    if (this == &rhs)
+        return;
+    free(heapBuffer);
+    if (rhs.isSSO())
+    {
+        heapBuffer = nullptr;
+        capacity = SSO_CAPACITY;
+        memcpy(sso, rhs.sso, rhs.len + 1);
+    }
+    else
+    {
+        heapBuffer = rhs.heapBuffer;
+        capacity = rhs.capacity;
+    }
+    len = rhs.len;
+    rhs.init();
+}
+
+String &String::operator=(const String &rhs)
+{
+    if (this == &rhs)
+        return *this;
+    return copy(rhs.buffer(), rhs.len);
+}
+
+String &String::operator=(const char *cstr)
+{
+    if (cstr)
+        return copy(cstr, strlen(cstr));
+    invalidate();
+    return *this;
+}
+
+String &String::operator=(String &&rval)
+{
+    move(rval);
+    return *this;
+}
+
+String &String::operator=(StringSumHelper &&rval)
+{
+    move(rval);
+    return *this;
+}
+#pragma endregion
+
+#pragma region Concatenation
+bool String::concat(const char *cstr, unsigned int length)
+{
+    if (!cstr)
+        return false;
+    if (length == 0)
+        return true;
+    const unsigned int newLen = len + length;
+    if (newLen > capacity)
+    {
+        // Grow geometrically so repeated appends stay amortized, as the device core does.
+        unsigned int newCapacity = capacity * 2 > newLen ? capacity * 2 : newLen;
+        // `cstr` may point into our own buffer.
+        const ptrdiff_t selfOffset = (cstr >= buffer() && cstr < buffer() + len) ? cstr - buffer() : -1;
+        if (!changeBuffer(newCapacity))
+            return false;
+        if (selfOffset >= 0)
+            cstr = buffer() + selfOffset;
+    }
+    memmove(buffer() + len, cstr, length);
+    len = newLen;
+    buffer()[len] = '\0';
+    return true;
+}
+
+bool String::concat(const String &str) { return concat(str.buffer(), str.len); }
+bool String::concat(const char *cstr) { return cstr && concat(cstr, strlen(cstr)); }
+bool String::concat(char c) { return concat(&c, 1); }
+bool String::concat(unsigned char num) { return concat(String(num)); }
+bool String::concat(int num) { return concat(String(num)); }
+bool String::concat(unsigned int num) { return concat(String(num)); }
+bool String::concat(long num) { return concat(String(num)); }
+bool String::concat(unsigned long num) { return concat(String(num)); }
+bool String::concat(long long num) { return concat(String(num)); }
+bool String::concat(unsigned long long num) { return concat(String(num)); }
+bool String::concat(float num) { return concat(String(num)); }
+bool String::concat(double num) { return concat(String(num)); }
+
+#define STRING_SUM_OPERATOR(type)                                          \
+    StringSumHelper &operator+(const StringSumHelper &lhs, type rhs)       \
+    {                                                                      \
+        StringSumHelper &result = const_cast<StringSumHelper &>(lhs);      \
+        result.concat(rhs);                                                \
+        return result;                                                     \
+    }
+
+STRING_SUM_OPERATOR(const String &)
+STRING_SUM_OPERATOR(const char *)
+STRING_SUM_OPERATOR(char)
+STRING_SUM_OPERATOR(unsigned char)
+STRING_SUM_OPERATOR(int)
+STRING_SUM_OPERATOR(unsigned int)
+STRING_SUM_OPERATOR(long)
+STRING_SUM_OPERATOR(unsigned long)
+STRING_SUM_OPERATOR(long long)
+STRING_SUM_OPERATOR(unsigned long long)
+STRING_SUM_OPERATOR(float)
+STRING_SUM_OPERATOR(double)
+#undef STRING_SUM_OPERATOR
+#pragma endregion
+
+#pragma region Comparison
+int String::compareTo(const String &s) const
+{
+    return strcmp(buffer(), s.buffer());
+}
+
+bool String::equals(const String &s) const
+{
+    return len == s.len && memcmp(buffer(), s.buffer(), len) == 0;
+}
+
+bool String::equals(const char *cstr) const
+{
+    if (!cstr)
+        return len == 0;
+    return strcmp(buffer(), cstr) == 0;
+}
+
+bool String::equalsIgnoreCase(const String &s) const
+{
+    if (len != s.len)
+        return false;
+    for (unsigned int i = 0; i < len; i++)
+    {
+        if (tolower(static_cast<unsigned char>(buffer()[i])) != tolower(static_cast<unsigned char>(s.buffer()[i])))
+            return false;
+    }
+    return true;
+}
+
+bool String::startsWith(const String &prefix) const
+{
+    return startsWith(prefix, 0);
+}
+
+bool String::startsWith(const String &prefix, unsigned int offset) const
+{
+    if (offset > len || prefix.len > len - offset)
+        return false;
+    return strncmp(buffer() + offset, prefix.buffer(), prefix.len) == 0;
+}
+
+bool String::endsWith(const String &suffix) const
+{
+    if (suffix.len > len)
+        return false;
+    return strcmp(buffer() + len - suffix.len, suffix.buffer()) == 0;
+}
+#pragma endregion
+
+#pragma region Character access
+char String::charAt(unsigned int index) const
+{
+    return operator[](index);
+}
+
+void String::setCharAt(unsigned int index, char c)
+{
+    if (index < len)
+        buffer()[index] = c;
+}
+
+char String::operator[](unsigned int index) const
+{
+    if (index >= len)
+        return '\0';
+    return buffer()[index];
+}
+
+char &String::operator[](unsigned int index)
+{
+    static char dummy;
+    if (index >= len)
+    {
+        dummy = '\0';
+        return dummy;
+    }
+    return buffer()[index];
+}
+
+void String::getBytes(unsigned char *buf, unsigned int bufsize, unsigned int index) const
+{
+    if (!bufsize || !buf)
+        return;
+    if (index >= len)
+    {
+        buf[0] = '\0';
+        return;
+    }
+    unsigned int n = bufsize - 1;
+    if (n > len - index)
+        n = len - index;
+    memcpy(buf, buffer() + index, n);
+    buf[n] = '\0';
+}
+
+void String::toCharArray(char *buf, unsigned int bufsize, unsigned int index) const
+{
+    getBytes(reinterpret_cast<unsigned char *>(buf), bufsize, index);
+}
+#pragma endregion
+
+#pragma region Search
+int String::indexOf(char ch) const
+{
+    return indexOf(ch, 0);
+}
+
+int String::indexOf(char ch, unsigned int fromIndex) const
+{
+    if (fromIndex >= len)
+        return -1;
+    const char *found = static_cast<const char *>(memchr(buffer() + fromIndex, ch, len - fromIndex));
+    return found ? static_cast<int>(found - buffer()) : -1;
+}
+
+int String::indexOf(const String &str) const
+{
+    return indexOf(str, 0);
+}
+
+int String::indexOf(const String &str, unsigned int fromIndex) const
+{
+    if (fromIndex >= len)
+        return -1;
+    const char *found = strstr(buffer() + fromIndex, str.buffer());
+    return found ? static_cast<int>(found - buffer()) : -1;
+}
+
+int String::lastIndexOf(char ch) const
+{
+    const char *found = strrchr(buffer(), ch);
+    return found ? static_cast<int>(found - buffer()) : -1;
+}
+
+String String::substring(unsigned int left, unsigned int right) const
+{
+    if (left > right)
+    {
+        const unsigned int temp = right;
+        right = left;
+        left = temp;
+    }
+    if (left >= len)
+        return String();
+    if (right > len)
+        right = len;
+    return String(buffer() + left, right - left);
+}
+#pragma endregion
+
+#pragma region Modification
+void String::replace(char find, char replace)
+{
+    for (char *p = buffer(); *p; p++)
+    {
+        if (*p == find)
+            *p = replace;
+    }
+}
+
+void String::replace(const String &find, const String &replace)
+{
+    if (find.isEmpty())
+        return;
+    String result;
+    int from = 0;
+    int index;
+    while ((index = indexOf(find, from)) >= 0)
+    {
+        result.concat(buffer() + from, index - from);
+        result.concat(replace);
+        from = index + find.len;
+    }
+    result.concat(buffer() + from, len - from);
+    *this = static_cast<String &&>(result);
+}
+
+void String::remove(unsigned int index)
+{
+    remove(index, static_cast<unsigned int>(-1));
+}
+
+void String::remove(unsigned int index, unsigned int count)
+{
+    if (index >= len || count == 0)
+        return;
+    if (count > len - index)
+        count = len - index;
+    char *writeTo = buffer() + index;
+    len -= count;
+    memmove(writeTo, writeTo + count, len - index);
+    buffer()[len] = '\0';
+}
+
+void String::toLowerCase()
+{
+    for (char *p = buffer(); *p; p++)
+        *p = static_cast<char>(tolower(static_cast<unsigned char>(*p)));
+}
+
+void String::toUpperCase()
+{
+    for (char *p = buffer(); *p; p++)
+        *p = static_cast<char>(toupper(static_cast<unsigned char>(*p)));
+}
+
+void String::trim()
+{
+    if (len == 0)
+        return;
+    char *begin = buffer();
+    while (isspace(static_cast<unsigned char>(*begin)))
+        begin++;
+    char *end = buffer() + len - 1;
+    while (end >= begin && isspace(static_cast<unsigned char>(*end)))
+        end--;
+    len = static_cast<unsigned int>(end + 1 - begin);
+    if (begin > buffer())
+        memmove(buffer(), begin, len);
+    buffer()[len] = '\0';
+}
+#pragma endregion
+
+#pragma region Parsing
+long String::toInt() const
+{
+    return atol(buffer());
+}
+
+float String::toFloat() const
+{
+    return static_cast<float>(toDouble());
+}
+
+double String::toDouble() const
+{
+    return atof(buffer());
+}
+#pragma endregion
@@ -0,0 +1,230 @@
+#include <stdio.h>
+#include <vector>
+#include <config-handler-core.h>
+#include <internal/Journal.h>
+#include <internal/Manifest.h>
+#include <internal/PackedConfiguration.h>
+
+namespace
+{
+    typedef std::vector<uint8_t> Blob;
+
+    // Batch entries refer to their key, which must outlive them.
+    const String PORT = "port";
+    const String HOST = "host";
+    const String TLS = "tls";
+
+    size_t failures = 0;
+
+    void check(const bool condition, const char *description)
+    {
+        if (!condition)
+        {
+            printf("FAILED: %s\n", description);
+            failures++;
+        }
+    }
+
+    /**
+     * @brief Every proper prefix of `blob`, as left by a write that was cut short.
+     */
+    std::vector<Blob> truncations(const Blob &blob)
+    {
+        std::vector<Blob> prefixes;
+        for (size_t size = 0; size < blob.size(); size++)
+            prefixes.emplace_back(blob.begin(), blob.begin() + size);
+        return prefixes;
+    }
+
+    /**
+     * @brief `blob` with one bit flipped in each byte in turn.
+     */
+    std::vector<Blob> corruptions(const Blob &blob)
+    {
+        std::vector<Blob> corrupted;
+        for (size_t i = 0; i < blob.size(); i++)
+        {
+            corrupted.push_back(blob);
+            corrupted.back()[i] ^= 0x10;
+        }
+        return corrupted;
+    }
+
+    /**
+     * @brief Replaces the trailing CRC-32 of `blob` so it matches the (modified) content.
+     */
+    void reseal(Blob &blob)
+    {
+        const size_t contentSize = blob.size() - 4;
+        uint32_t crc = PackedConfiguration::crc32(blob.data(), contentSize);
+        for (size_t i = 0; i < 4; i++, crc >>= 8)
+            blob[contentSize + i] = static_cast<uint8_t>(crc);
+    }
+
+#pragma region Sample blobs
+    Journal sampleJournal()
+    {
+        const int32_t port = 8883;
+        const String host = "broker.local";
+        Journal journal;
+        journal.open("/mqtt", FileMode::WRITE);
+        journal.write(StorageMedium::BatchEntry(PORT, &port));
+        journal.write(StorageMedium::BatchEntry(HOST, &host));
+        journal.writeBlob("/packed", {1, 2, 3});
+        journal.remove("/stale");
+        return journal;
+    }
+
+    struct PackedSample
+    {
+        int32_t port = 1883;
+        String host = "broker.local";
+        bool tls = true;
+
+        std::vector<StorageMedium::BatchEntry> entries()
+        {
+            return {StorageMedium::BatchEntry(PORT, &port), StorageMedium::BatchEntry(HOST, &host), StorageMedium::BatchEntry(TLS, &tls)};
+        }
+    };
+
+    Blob samplePacked()
+    {
+        PackedSample sample;
+        const auto entries = sample.entries();
+        return PackedConfiguration::encode(entries.data(), entries.size());
+    }
+
+    Manifest sampleManifest()
+    {
+        Manifest manifest;
+        manifest.set("/mqtt", {true, true, 0x22222222, 0x33333333, 0x22222222});
+        manifest.set("/wifi", {true, false, 0x55555555, 0, 0});
+        return manifest;
+    }
+#pragma endregion
+
+    void testJournal()
+    {
+        const Blob blob = sampleJournal().encode();
+
+        MemoryStorageMedium medium;
+        medium.createFileHandler("/stale", FileMode::WRITE).write<int32_t>(PORT, 1);
+        Journal decoded;
+        check(decoded.decode(blob), "journal: decodes what it encoded");
+        decoded.apply(medium);
+        {
+            const StorageMedium::FileHandler fileHandler = medium.createFileHandler("/mqtt", FileMode::READ);
+            check(fileHandler.read<int32_t>(PORT) == 8883 && fileHandler.read<String>(HOST) == "broker.local", "journal: replays the writes");
+        }
+        Blob packed;
+        check(medium.readBlob("/packed", packed) && packed == Blob({1, 2, 3}), "journal: replays the blob");
+        check(!medium.exists("/stale"), "journal: replays the deletion");
+
+        for (const Blob &truncated : truncations(blob))
+            check(!decoded.decode(truncated) && decoded.empty(), "journal: rejects a truncated journal");
+        for (const Blob &corrupted : corruptions(blob))
+            check(!decoded.decode(corrupted) && decoded.empty(), "journal: rejects a corrupt journal");
+        check(!decoded.decode(samplePacked()), "journal: rejects a packed configuration");
+        check(!decoded.decode(sampleManifest().encode()), "journal: rejects a manifest");
+
+        // Records that pass the checksum but hold values the reader does not know.
+        Blob badFileMode = blob;
+        // Header (3 + 1 + 2 bytes), then the kind of the first record (open) and its file mode.
+        badFileMode[7] = 0xFF;
+        reseal(badFileMode);
+        check(!decoded.decode(badFileMode), "journal: rejects an unknown file mode");
+        Blob badKind = blob;
+        badKind[6] = 0xFF;
+        reseal(badKind);
+        check(!decoded.decode(badKind), "journal: rejects an unknown record kind");
+        Blob badVersion = blob;
+        badVersion[3] = Journal::VERSION + 1;
+        reseal(badVersion);
+        check(!decoded.decode(badVersion), "journal: rejects another format version");
+    }
+
+    void testPackedConfiguration()
+    {
+        const Blob blob = samplePacked();
+
+        PackedSample decoded;
+        decoded.port = 0;
+        decoded.host = "";
+        decoded.tls = false;
+        auto entries = decoded.entries();
+        check(PackedConfiguration::decode(blob, entries.data(), entries.size()) == PackedConfiguration::DecodeResult::OK,
+              "packed: decodes what it encoded");
+        check(decoded.port == 1883 && decoded.host == "broker.local" && decoded.tls, "packed: reads the values back");
+
+        PackedSample untouched;
+        untouched.port = 7;
+        auto untouchedEntries = untouched.entries();
+        for (const Blob &truncated : truncations(blob))
+        {
+            check(PackedConfiguration::decode(truncated, untouchedEntries.data(), untouchedEntries.size()) == PackedConfiguration::DecodeResult::CORRUPT,
+                  "packed: rejects a truncated blob");
+            std::vector<uint32_t> offsets;
+            size_t blobSize;
+            check(PackedConfiguration::index(truncated.data(), truncated.size(), untouchedEntries.data(), untouchedEntries.size(), offsets, blobSize) ==
+                      PackedConfiguration::DecodeResult::CORRUPT,
+                  "packed: does not index a truncated blob");
+        }
+        for (const Blob &corrupted : corruptions(blob))
+            check(PackedConfiguration::decode(corrupted, untouchedEntries.data(), untouchedEntries.size()) == PackedConfiguration::DecodeResult::CORRUPT,
+                  "packed: rejects a corrupt blob");
+        check(PackedConfiguration::decode(sampleJournal().encode(), untouchedEntries.data(), untouchedEntries.size()) == PackedConfiguration::DecodeResult::CORRUPT,
+              "packed: rejects a journal");
+        check(PackedConfiguration::decode(sampleManifest().encode(), untouchedEntries.data(), untouchedEntries.size()) == PackedConfiguration::DecodeResult::CORRUPT,
+              "packed: rejects a manifest");
+        check(untouched.port == 7, "packed: leaves the values unchanged when it rejects a blob");
+
+        // A valid blob written with other fields.
+        int32_t port = 0;
+        String host;
+        const StorageMedium::BatchEntry otherFields[] = {StorageMedium::BatchEntry(PORT, &port), StorageMedium::BatchEntry(HOST, &host)};
+        check(PackedConfiguration::decode(blob, otherFields, 2) == PackedConfiguration::DecodeResult::STALE_SCHEMA, "packed: detects a stale schema");
+    }
+
+    void testManifest()
+    {
+        const Manifest manifest = sampleManifest();
+        const Blob blob = manifest.encode();
+
+        Manifest decoded;
+        check(decoded.decode(blob), "manifest: decodes what it encoded");
+        const Manifest::Entry *mqtt = decoded.find("/mqtt");
+        const Manifest::Entry *wifi = decoded.find("/wifi");
+        check(mqtt != nullptr && *mqtt == *manifest.find("/mqtt") && wifi != nullptr && *wifi == *manifest.find("/wifi"),
+              "manifest: reads the entries back");
+
+        for (const Blob &truncated : truncations(blob))
+            check(!decoded.decode(truncated) && decoded.find("/mqtt") == nullptr, "manifest: rejects a truncated manifest");
+        for (const Blob &corrupted : corruptions(blob))
+            check(!decoded.decode(corrupted) && decoded.find("/mqtt") == nullptr, "manifest: rejects a corrupt manifest");
+        check(!decoded.decode(sampleJournal().encode()), "manifest: rejects a journal");
+        check(!decoded.decode(samplePacked()), "manifest: rejects a packed configuration");
+
+        // Header (3 + 1 + 2 bytes), then the first file name (2 + 5 bytes), its presence and its completeness.
+        for (const size_t flag : {13, 14})
+        {
+            Blob badFlag = blob;
+            badFlag[flag] = 2;
+            reseal(badFlag);
+            check(!decoded.decode(badFlag), "manifest: rejects a flag other than 0 and 1");
+        }
+    }
+}
+
+int main()
+{
+    testJournal();
+    testPackedConfiguration();
+    testManifest();
+    if (failures != 0)
+    {
+        printf("%lu checks failed\n", static_cast<unsigned long>(failures));
+        return 1;
+    }
+    printf("All checks passed\n");
+    return 0;
+}
@@ -0,0 +1,129 @@
+#include <cfloat>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <internal/string-utils.h>
+
+namespace
+{
+    size_t failures = 0;
+
+    void check(const bool condition, const char *description, const char *text)
+    {
+        if (!condition)
+        {
+            printf("FAILED: %s: \"%s\"\n", description, text);
+            failures++;
+        }
+    }
+
+    template <typename T>
+    void accepts(bool (*parse)(const char *, size_t, T *), const char *text, const T expected, const char *description)
+    {
+        T result{};
+        check(parse(text, strlen(text), &result) && memcmp(&result, &expected, sizeof(T)) == 0, description, text);
+    }
+
+    template <typename T>
+    void rejects(bool (*parse)(const char *, size_t, T *), const char *text, const char *description)
+    {
+        const T untouched = static_cast<T>(7);
+        T result = untouched;
+        check(!parse(text, strlen(text), &result) && result == untouched, description, text);
+    }
+
+    void testIntegers()
+    {
+        accepts<int32_t>(tryParseInt32, "2147483647", INT32_MAX, "int32: accepts the maximum");
+        accepts<int32_t>(tryParseInt32, "-2147483648", INT32_MIN, "int32: accepts the minimum");
+        accepts<int32_t>(tryParseInt32, "+42", 42, "int32: accepts a plus sign");
+        accepts<int32_t>(tryParseInt32, "-0", 0, "int32: accepts minus zero");
+        rejects<int32_t>(tryParseInt32, "2147483648", "int32: rejects the maximum + 1");
+        rejects<int32_t>(tryParseInt32, "-2147483649", "int32: rejects the minimum - 1");
+        rejects<int32_t>(tryParseInt32, "99999999999999999999", "int32: rejects a value that overflows 64 bits");
+
+        accepts<int64_t>(tryParseInt64, "9223372036854775807", INT64_MAX, "int64: accepts the maximum");
+        accepts<int64_t>(tryParseInt64, "-9223372036854775808", INT64_MIN, "int64: accepts the minimum");
+        rejects<int64_t>(tryParseInt64, "9223372036854775808", "int64: rejects the maximum + 1");
+        rejects<int64_t>(tryParseInt64, "-9223372036854775809", "int64: rejects the minimum - 1");
+
+        accepts<uint64_t>(tryParseUInt64, "18446744073709551615", UINT64_MAX, "uint64: accepts the maximum");
+        accepts<uint64_t>(tryParseUInt64, "+1", 1, "uint64: accepts a plus sign");
+        rejects<uint64_t>(tryParseUInt64, "18446744073709551616", "uint64: rejects the maximum + 1");
+        rejects<uint64_t>(tryParseUInt64, "-1", "uint64: rejects a minus sign");
+
+        for (const char *text : {"", "-", "+", " 1", "1 ", "0x10", "1.0", "1e3", "--1"})
+        {
+            rejects<int32_t>(tryParseInt32, text, "int32: rejects what is not an integer");
+            rejects<int64_t>(tryParseInt64, text, "int64: rejects what is not an integer");
+            rejects<uint64_t>(tryParseUInt64, text, "uint64: rejects what is not an integer");
+        }
+    }
+
+    void testFloatingPoint()
+    {
+        accepts<double>(tryParseDouble, "1.5", 1.5, "double: accepts a decimal");
+        accepts<double>(tryParseDouble, ".5", 0.5, "double: accepts a missing integer part");
+        accepts<double>(tryParseDouble, "5.", 5.0, "double: accepts a missing fraction");
+        accepts<double>(tryParseDouble, "-1e-3", -0.001, "double: accepts an exponent");
+        accepts<double>(tryParseDouble, "-0", -0.0, "double: keeps the sign of zero");
+        accepts<double>(tryParseDouble, "1.7976931348623157e308", DBL_MAX, "double: accepts the maximum");
+        accepts<double>(tryParseDouble, "4.9406564584124654e-324", 4.9406564584124654e-324, "double: accepts the smallest subnormal");
+        accepts<double>(tryParseDouble, "1e-400", 0.0, "double: rounds a value below the range to zero");
+        accepts<double>(tryParseDouble, "0e999999", 0.0, "double: accepts zero with a huge exponent");
+        // More digits than the fast path reads: converted by strtod.
+        accepts<double>(tryParseDouble, "0.1000000000000000055511151231257827", 0.1, "double: rounds long mantissas");
+        accepts<double>(tryParseDouble, "123456789012345678901234567890", 123456789012345678901234567890.0, "double: rounds long integers");
+        rejects<double>(tryParseDouble, "1.8e308", "double: rejects a value above the range");
+        rejects<double>(tryParseDouble, "1e999999", "double: rejects a huge exponent");
+
+        accepts<float>(tryParseFloat, "0.1", 0.1f, "float: accepts a decimal");
+        accepts<float>(tryParseFloat, "3.4028235e38", FLT_MAX, "float: accepts the maximum");
+        accepts<float>(tryParseFloat, "3.40282356e38", FLT_MAX, "float: rounds a value just below the overflow threshold to the maximum");
+        accepts<float>(tryParseFloat, "1.4e-45", 1.4e-45f, "float: accepts the smallest subnormal");
+        rejects<float>(tryParseFloat, "3.5e38", "float: rejects a value above the range");
+        // Just above halfway between 1 and the next float: a double rounds it down to halfway, and then to 1 (ties to even).
+        accepts<float>(tryParseFloat, "1.000000059604644776", 1.00000012f, "float: rounds once (19 digits)");
+        accepts<float>(tryParseFloat, "1.0000000596046447753906251", 1.00000012f, "float: rounds once (long mantissa)");
+        accepts<float>(tryParseFloat, "16777217", 16777216.0f, "float: rounds an integer above 2^24");
+
+        for (const char *text : {"", "-", ".", "e5", "1e", "1e+", "1ex", "1.2.3", " 1", "1 ", "inf", "nan", "0x1p3"})
+        {
+            rejects<double>(tryParseDouble, text, "double: rejects what is not a number");
+            rejects<float>(tryParseFloat, text, "float: rejects what is not a number");
+        }
+    }
+
+    void testFormatting()
+    {
+        check(formatFloat(0.1f) == "0.1", "formatFloat: shortest text", "0.1");
+        check(formatDouble(0.1) == "0.1", "formatDouble: shortest text", "0.1");
+        for (const float value : {FLT_MAX, FLT_MIN, 1.00000012f, -3.14159274f, 16777216.0f})
+        {
+            const String text = formatFloat(value);
+            float parsed;
+            check(tryParseFloat(text.c_str(), text.length(), &parsed) && parsed == value, "formatFloat: parses back", text.c_str());
+        }
+        for (const double value : {DBL_MAX, DBL_MIN, 0.30000000000000004, -2.5e-300})
+        {
+            const String text = formatDouble(value);
+            double parsed;
+            check(tryParseDouble(text.c_str(), text.length(), &parsed) && parsed == value, "formatDouble: parses back", text.c_str());
+        }
+    }
+}
+
+int main()
+{
+    testIntegers();
+    testFloatingPoint();
+    testFormatting();
+    if (failures != 0)
+    {
+        printf("%lu checks failed\n", static_cast<unsigned long>(failures));
+        return 1;
+    }
+    printf("All checks passed\n");
+    return 0;
+}
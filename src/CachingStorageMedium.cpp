@@ -0,0 +1,488 @@
+#include <float.h>
+#include <stdexcept>
+#include "CachingStorageMedium.h"
+#include "internal/Fnv1a.h"
+
+namespace
+{
+    /// @brief The size of the node of a `std::map` besides its value (the links and the color).
+    constexpr size_t NODE_OVERHEAD = 4 * sizeof(void *);
+
+    /**
+     * @brief FNV-1a over the parameters' names, the terminating nulls separate the names.
+     */
+    uint32_t hashParameters(const std::vector<ParameterInfo> &parameters)
+    {
+        uint32_t hash = Fnv1a::OFFSET_BASIS;
+        for (const ParameterInfo &parameter : parameters)
+            Fnv1a::add(hash, parameter.name);
+        return hash;
+    }
+
+    /**
+     * @brief A variable for each type a parameter is usually stored as, holding a value that is unlikely to be stored.
+     */
+    struct Probe
+    {
+        int32_t integer = INT32_MIN;
+        float real = -FLT_MAX;
+        bool boolean = false;
+        String text = "\x01";
+
+        StorageMedium::BatchEntry getEntry(const ParameterInfo &parameter)
+        {
+            switch (parameter.type)
+            {
+            case ParameterType::TYPE_INT:
+                return StorageMedium::BatchEntry(parameter.name, &integer);
+            case ParameterType::TYPE_FLOAT:
+                return StorageMedium::BatchEntry(parameter.name, &real);
+            case ParameterType::TYPE_BOOL:
+                return StorageMedium::BatchEntry(parameter.name, &boolean);
+            default:
+                return StorageMedium::BatchEntry(parameter.name, &text);
+            }
+        }
+    };
+}
+
+bool CachingStorageMedium::CacheKeyOrder::operator()(const CacheKeyRef &a, const CacheKeyRef &b) const
+{
+    if (a.fileName != b.fileName)
+    {
+        const int fileOrder = a.fileName->compareTo(*b.fileName);
+        if (fileOrder != 0)
+            return fileOrder < 0;
+    }
+    if (a.kind != b.kind)
+        return a.kind < b.kind;
+    // Only the values have a key.
+    return a.key != b.key && *a.key < *b.key;
+}
+
+CachingStorageMedium::CachingStorageMedium(StorageMedium &inner, const size_t capacity)
+    : StorageMediumDecorator(inner), capacity(capacity), entries(), names(), newest(nullptr), oldest(nullptr), usedBytes(0), hits(0), misses(0),
+      currentFile(nullptr), readOpen(false), innerOpen(false)
+{
+    if (capacity == 0)
+        throw std::invalid_argument("The cache's capacity must not be zero!");
+}
+
+void CachingStorageMedium::clear()
+{
+    // One by one, so the name of the open file stays interned.
+    while (oldest != nullptr)
+        erase(entries.find(*oldest->key));
+}
+
+bool CachingStorageMedium::openFile(const String &fileName, const FileMode fileMode)
+{
+    // Lookups in the open file compare the interned name by address.
+    setCurrentFile(intern(fileName));
+    readOpen = false;
+    innerOpen = false;
+    if (fileMode == FileMode::READ)
+    {
+        // The file is opened on the inner medium when a value that is not cached is read.
+        if (lookupExists(fileName, readOpen))
+            return readOpen;
+        innerOpen = readOpen = StorageMediumDecorator::openFile(fileName, fileMode);
+        if (innerOpen)
+            storeFound(fileName, EntryKind::EXISTS, true);
+        return innerOpen;
+    }
+
+    innerOpen = StorageMediumDecorator::openFile(fileName, fileMode);
+    // The writes can change whether the file is complete, and `FileMode::WRITE` clears its values.
+    if (fileMode == FileMode::WRITE)
+        forgetFile(fileName);
+    else
+        forget(fileName, EntryKind::COMPLETE);
+    if (innerOpen)
+        storeFound(fileName, EntryKind::EXISTS, true);
+    return innerOpen;
+}
+
+void CachingStorageMedium::closeFile()
+{
+    if (innerOpen)
+        StorageMediumDecorator::closeFile();
+    setCurrentFile(nullptr);
+    readOpen = false;
+    innerOpen = false;
+}
+
+OpenResult CachingStorageMedium::openFileIfExists(const String &fileName)
+{
+    // Lookups in the open file compare the interned name by address.
+    setCurrentFile(intern(fileName));
+    readOpen = false;
+    innerOpen = false;
+    if (lookupExists(fileName, readOpen))
+        return readOpen ? OpenResult::OPENED : OpenResult::NOT_FOUND;
+    const OpenResult result = StorageMediumDecorator::openFileIfExists(fileName);
+    if (result != OpenResult::FAILED)
+        storeFound(fileName, EntryKind::EXISTS, result == OpenResult::OPENED);
+    innerOpen = readOpen = result == OpenResult::OPENED;
+    return result;
+}
+
+bool CachingStorageMedium::existsImpl(const String &fileName)
+{
+    bool found;
+    if (lookupExists(fileName, found))
+        return found;
+    found = StorageMediumDecorator::existsImpl(fileName);
+    storeFound(fileName, EntryKind::EXISTS, found);
+    return found;
+}
+
+bool CachingStorageMedium::isCompleteImpl(const String &fileName, const std::vector<ParameterInfo> &parameters)
+{
+    const uint32_t parametersHash = hashParameters(parameters);
+    const CacheEntry *complete = find(fileName, EntryKind::COMPLETE);
+    if (complete != nullptr && complete->parametersHash == parametersHash)
+    {
+        hits++;
+        return complete->found;
+    }
+    bool exists;
+    if (lookupExists(fileName, exists) && !exists)
+        return false;
+    misses++;
+    bool found;
+    // Reading the keys needs the file open on the inner medium, which it cannot be while another file is open through this medium.
+    if (currentFile != nullptr)
+        found = StorageMediumDecorator::isCompleteImpl(fileName, parameters);
+    else
+    {
+        setCurrentFile(intern(fileName));
+        found = readComplete(currentFile->first, parameters);
+        setCurrentFile(nullptr);
+    }
+    CacheEntry &entry = insert(fileName, EntryKind::COMPLETE);
+    entry.found = found;
+    entry.parametersHash = parametersHash;
+    account(entry);
+    return found;
+}
+
+bool CachingStorageMedium::deleteImpl(const String &fileName)
+{
+    const bool deleted = StorageMediumDecorator::deleteImpl(fileName);
+    forgetFile(fileName);
+    if (deleted)
+        storeFound(fileName, EntryKind::EXISTS, false);
+    return deleted;
+}
+
+bool CachingStorageMedium::readBlobImpl(const String &fileName, std::vector<uint8_t> &data)
+{
+    const CacheEntry *blob = find(fileName, EntryKind::BLOB);
+    if (blob != nullptr)
+    {
+        hits++;
+        if (blob->found)
+            data = blob->blob;
+        return blob->found;
+    }
+    misses++;
+    const bool found = StorageMediumDecorator::readBlobImpl(fileName, data);
+    CacheEntry &entry = insert(fileName, EntryKind::BLOB);
+    entry.found = found;
+    if (found)
+        entry.blob = data;
+    account(entry);
+    return found;
+}
+
+bool CachingStorageMedium::writeBlobImpl(const String &fileName, const std::vector<uint8_t> &data)
+{
+    const bool written = StorageMediumDecorator::writeBlobImpl(fileName, data);
+    if (!written)
+    {
+        forget(fileName, EntryKind::BLOB);
+        return false;
+    }
+    CacheEntry &entry = insert(fileName, EntryKind::BLOB);
+    entry.found = true;
+    entry.blob = data;
+    account(entry);
+    return true;
+}
+
+bool CachingStorageMedium::deleteBlobImpl(const String &fileName)
+{
+    const bool deleted = StorageMediumDecorator::deleteBlobImpl(fileName);
+    if (deleted)
+        storeFound(fileName, EntryKind::BLOB, false);
+    else
+        forget(fileName, EntryKind::BLOB);
+    return deleted;
+}
+
+void CachingStorageMedium::readBatch(const BatchEntry *entries, const size_t count)
+{
+    // The values that are not cached are read from the inner medium in one batch.
+    std::vector<BatchEntry> missing;
+    std::vector<StagedValue> defaultValues;
+    for (size_t i = 0; i < count; i++)
+    {
+        if (lookupValue(currentFile->first, entries[i]))
+            continue;
+        missing.push_back(entries[i]);
+        defaultValues.emplace_back(entries[i]);
+    }
+    if (missing.empty() || !openInner())
+        return;
+    StorageMediumDecorator::readBatch(missing.data(), missing.size());
+    for (size_t i = 0; i < missing.size(); i++)
+        storeRead(currentFile->first, missing[i], defaultValues[i]);
+}
+
+void CachingStorageMedium::writeBatch(const BatchEntry *entries, const size_t count)
+{
+    StorageMediumDecorator::writeBatch(entries, count);
+    for (size_t i = 0; i < count; i++)
+        storeWritten(entries[i]);
+}
+
+CachingStorageMedium::CacheEntry *CachingStorageMedium::find(const String &fileName, const EntryKind kind, const String *key)
+{
+    const auto &it = entries.find(CacheKeyRef{&fileName, kind, key});
+    if (it == entries.end())
+        return nullptr;
+    touch(it->second);
+    return &it->second;
+}
+
+CachingStorageMedium::CacheEntry &CachingStorageMedium::insert(const String &fileName, const EntryKind kind, const String *key)
+{
+    const CacheKeyRef ref = {&fileName, kind, key};
+    const auto &position = entries.lower_bound(ref);
+    if (position != entries.end() && !entries.key_comp()(ref, position->first))
+    {
+        touch(position->second);
+        return position->second;
+    }
+    const CacheKey interned = {intern(fileName), kind, key != nullptr ? intern(*key) : nullptr};
+    const auto &it = entries.emplace_hint(position, interned, CacheEntry());
+    CacheEntry &entry = it->second;
+    entry.key = &it->first;
+    entry.older = newest;
+    if (newest != nullptr)
+        newest->newer = &entry;
+    else
+        oldest = &entry;
+    newest = &entry;
+    return entry;
+}
+
+void CachingStorageMedium::touch(CacheEntry &entry)
+{
+    if (newest == &entry)
+        return;
+    // Move the entry to the front of the recency order.
+    entry.newer->older = entry.older;
+    if (entry.older != nullptr)
+        entry.older->newer = entry.newer;
+    else
+        oldest = entry.newer;
+    entry.newer = nullptr;
+    entry.older = newest;
+    newest->newer = &entry;
+    newest = &entry;
+}
+
+void CachingStorageMedium::account(CacheEntry &entry)
+{
+    usedBytes -= entry.bytes;
+    // The map node, and the heap buffers of the values and of the blob (the names are counted once, by `intern`).
+    entry.bytes = NODE_OVERHEAD + sizeof(CacheKey) + sizeof(CacheEntry) + entry.value.getText().length() +
+                  entry.defaultValue.getText().length() + entry.blob.capacity();
+    usedBytes += entry.bytes;
+    // This evicts `entry` too if it does not fit on its own.
+    while (usedBytes > capacity && oldest != nullptr)
+        erase(entries.find(*oldest->key));
+}
+
+void CachingStorageMedium::erase(std::map<CacheKey, CacheEntry, CacheKeyOrder>::iterator it)
+{
+    CacheEntry &entry = it->second;
+    if (entry.newer != nullptr)
+        entry.newer->older = entry.older;
+    else
+        newest = entry.older;
+    if (entry.older != nullptr)
+        entry.older->newer = entry.newer;
+    else
+        oldest = entry.newer;
+    usedBytes -= entry.bytes;
+    const CacheKey key = it->first;
+    entries.erase(it);
+    release(key.fileName);
+    if (key.key != nullptr)
+        release(key.key);
+}
+
+void CachingStorageMedium::forget(const String &fileName, const EntryKind kind)
+{
+    const auto &it = entries.find(CacheKeyRef{&fileName, kind, nullptr});
+    if (it != entries.end())
+        erase(it);
+}
+
+void CachingStorageMedium::forgetFile(const String &fileName)
+{
+    // Blobs are kept apart from the file's keys, they stay cached.
+    auto it = entries.lower_bound(CacheKeyRef{&fileName, EntryKind::EXISTS, nullptr});
+    while (it != entries.end() && it->first.fileName->first == fileName)
+    {
+        const auto next = std::next(it);
+        if (it->first.kind != EntryKind::BLOB)
+            erase(it);
+        it = next;
+    }
+}
+
+CachingStorageMedium::Name *CachingStorageMedium::intern(const String &name)
+{
+    // The names of the current file's answers are the current file's name.
+    if (currentFile != nullptr && &name == &currentFile->first)
+    {
+        currentFile->second++;
+        return currentFile;
+    }
+    auto it = names.find(name);
+    if (it == names.end())
+    {
+        it = names.emplace(name, 0).first;
+        usedBytes += NODE_OVERHEAD + sizeof(Name) + name.length();
+    }
+    it->second++;
+    return &*it;
+}
+
+void CachingStorageMedium::release(Name *name)
+{
+    if (--name->second != 0)
+        return;
+    usedBytes -= NODE_OVERHEAD + sizeof(Name) + name->first.length();
+    names.erase(names.find(name->first));
+}
+
+void CachingStorageMedium::setCurrentFile(Name *file)
+{
+    if (currentFile != nullptr)
+        release(currentFile);
+    currentFile = file;
+}
+
+bool CachingStorageMedium::openInner()
+{
+    if (!innerOpen && readOpen)
+    {
+        innerOpen = StorageMediumDecorator::openFile(currentFile->first, FileMode::READ);
+        if (!innerOpen)
+            forget(currentFile->first, EntryKind::EXISTS);
+    }
+    return innerOpen;
+}
+
+bool CachingStorageMedium::lookupExists(const String &fileName, bool &found)
+{
+    const CacheEntry *exists = find(fileName, EntryKind::EXISTS);
+    // A file known to be complete exists.
+    const CacheEntry *complete = exists == nullptr ? find(fileName, EntryKind::COMPLETE) : nullptr;
+    if (exists == nullptr && (complete == nullptr || !complete->found))
+    {
+        misses++;
+        return false;
+    }
+    hits++;
+    found = exists != nullptr ? exists->found : true;
+    return true;
+}
+
+bool CachingStorageMedium::readComplete(const String &fileName, const std::vector<ParameterInfo> &parameters)
+{
+    // Each key that is not known to be stored is read as the type its parameter is usually stored as, with a default value
+    // that is unlikely to be stored: a value other than the default is stored, and is cached for the load that usually follows.
+    std::vector<Probe> probes(parameters.size());
+    std::vector<BatchEntry> unknown;
+    std::vector<size_t> unknownParameters;
+    std::vector<ParameterInfo> unchecked;
+    for (size_t i = 0; i < parameters.size(); i++)
+    {
+        const CacheEntry *cached = find(fileName, EntryKind::VALUE, &parameters[i].name);
+        if (cached != nullptr && cached->stored)
+            continue;
+        if (cached != nullptr)
+            unchecked.push_back(parameters[i]);
+        else
+        {
+            unknown.push_back(probes[i].getEntry(parameters[i]));
+            unknownParameters.push_back(i);
+        }
+    }
+    if (!unknown.empty())
+    {
+        if (!StorageMediumDecorator::openFile(fileName, FileMode::READ))
+            return StorageMediumDecorator::isCompleteImpl(fileName, parameters);
+        Probe defaults;
+        StorageMediumDecorator::readBatch(unknown.data(), unknown.size());
+        StorageMediumDecorator::closeFile();
+        for (size_t i = 0; i < unknown.size(); i++)
+        {
+            const ParameterInfo &parameter = parameters[unknownParameters[i]];
+            const StagedValue defaultValue(defaults.getEntry(parameter));
+            if (StagedValue(unknown[i]) != defaultValue)
+                storeRead(fileName, unknown[i], defaultValue);
+            else
+                // The key is missing, stored as another type (which reads as the default), or holds the default: the inner medium tells.
+                unchecked.push_back(parameter);
+        }
+    }
+    return unchecked.empty() || StorageMediumDecorator::isCompleteImpl(fileName, unchecked);
+}
+
+bool CachingStorageMedium::lookupValue(const String &fileName, const BatchEntry &entry)
+{
+    const CacheEntry *cached = find(fileName, EntryKind::VALUE, &entry.getKey());
+    // A value that may be the default value it was read with is only reused with the same default value (the entry's current value).
+    if (cached == nullptr || cached->value.getType() != entry.getType() || (!cached->stored && cached->defaultValue != StagedValue(entry)))
+    {
+        misses++;
+        return false;
+    }
+    hits++;
+    cached->value.copyTo(entry);
+    return true;
+}
+
+void CachingStorageMedium::storeRead(const String &fileName, const BatchEntry &entry, const StagedValue &defaultValue)
+{
+    CacheEntry &cached = insert(fileName, EntryKind::VALUE, &entry.getKey());
+    cached.value = StagedValue(entry);
+    cached.defaultValue = defaultValue;
+    cached.stored = cached.value != defaultValue;
+    account(cached);
+}
+
+void CachingStorageMedium::storeWritten(const BatchEntry &entry)
+{
+    CacheEntry &cached = insert(currentFile->first, EntryKind::VALUE, &entry.getKey());
+    cached.value = StagedValue(entry);
+    cached.defaultValue = StagedValue();
+    cached.stored = true;
+    account(cached);
+}
+
+void CachingStorageMedium::storeFound(const String &fileName, const EntryKind kind, const bool found)
+{
+    CacheEntry &entry = insert(fileName, kind);
+    entry.found = found;
+    // A deleted blob's bytes are not kept.
+    std::vector<uint8_t>().swap(entry.blob);
+    account(entry);
+}
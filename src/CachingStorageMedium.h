@@ -0,0 +1,222 @@
+#ifndef __H_CACHING_STORAGE_MEDIUM__
+#define __H_CACHING_STORAGE_MEDIUM__
+#include <WString.h>
+#include <map>
+#include <stdint.h>
+#include <vector>
+#include "StorageMediumDecorator.h"
+#include "internal/StagedValue.h"
+
+/**
+ * @brief A storage medium that keeps the answers of another medium in an LRU cache bounded in bytes:
+ * the values of the keys that were read, whether files exist, whether files are complete, and blobs.
+ *
+ * Repeated probes of the same file (e.g. `configsExist`, `configsAreComplete` and `loadConfigurations` at boot) reach the inner medium once per key:
+ * a completeness check reads the parameters' keys in one batch and caches their values for the load that follows,
+ * and a file opened for reading is only opened on the inner medium when a value that is not cached is read.
+ * Writes go through to the inner medium and update the cache, opening a file for writing forgets its completeness
+ * (and with `FileMode::WRITE` its values), and deleting a file or a blob forgets everything cached about it.
+ *
+ * A value read while its key is missing is the default value, so it is only reused for reads with the same default value.
+ * Changes made to the inner medium directly (not through this medium) are not seen until `clear` is called.
+ *
+ */
+class CachingStorageMedium : public StorageMediumDecorator
+{
+public:
+    /**
+     * @param inner The medium whose answers are cached.
+     * @param capacity The maximum number of bytes the cached answers take, with their bookkeeping (a value takes about 220 bytes, a blob its size more).
+     * An answer larger than the whole capacity is not cached.
+     */
+    CachingStorageMedium(StorageMedium &inner, const size_t capacity = 8192);
+
+    /**
+     * @brief Forgets everything that was cached.
+     */
+    void clear();
+
+    size_t size() const { return entries.size(); }
+    size_t getUsedBytes() const { return usedBytes; }
+    uint32_t getHits() const { return hits; }
+    uint32_t getMisses() const { return misses; }
+
+protected:
+    bool openFile(const String &fileName, const FileMode fileMode) override;
+    void closeFile() override;
+    OpenResult openFileIfExists(const String &fileName) override;
+
+    bool existsImpl(const String &fileName) override;
+    bool isCompleteImpl(const String &fileName, const std::vector<ParameterInfo> &parameters) override;
+    bool deleteImpl(const String &fileName) override;
+
+    bool readBlobImpl(const String &fileName, std::vector<uint8_t> &data) override;
+    bool writeBlobImpl(const String &fileName, const std::vector<uint8_t> &data) override;
+    bool deleteBlobImpl(const String &fileName) override;
+
+#pragma region Read and Write functions
+    int8_t readChar(const String &key, const int8_t defaultValue) override { return readValue(key, defaultValue, [&]() { return StorageMediumDecorator::readChar(key, defaultValue); }); }
+    uint8_t readUChar(const String &key, const uint8_t defaultValue) override { return readValue(key, defaultValue, [&]() { return StorageMediumDecorator::readUChar(key, defaultValue); }); }
+    int16_t readShort(const String &key, const int16_t defaultValue) override { return readValue(key, defaultValue, [&]() { return StorageMediumDecorator::readShort(key, defaultValue); }); }
+    uint16_t readUShort(const String &key, const uint16_t defaultValue) override { return readValue(key, defaultValue, [&]() { return StorageMediumDecorator::readUShort(key, defaultValue); }); }
+    int32_t readInt(const String &key, const int32_t defaultValue) override { return readValue(key, defaultValue, [&]() { return StorageMediumDecorator::readInt(key, defaultValue); }); }
+    uint32_t readUInt(const String &key, const uint32_t defaultValue) override { return readValue(key, defaultValue, [&]() { return StorageMediumDecorator::readUInt(key, defaultValue); }); }
+    int64_t readLong(const String &key, const int64_t defaultValue) override { return readValue(key, defaultValue, [&]() { return StorageMediumDecorator::readLong(key, defaultValue); }); }
+    uint64_t readULong(const String &key, const uint64_t defaultValue) override { return readValue(key, defaultValue, [&]() { return StorageMediumDecorator::readULong(key, defaultValue); }); }
+    float readFloat(const String &key, const float defaultValue) override { return readValue(key, defaultValue, [&]() { return StorageMediumDecorator::readFloat(key, defaultValue); }); }
+    double readDouble(const String &key, const double defaultValue) override { return readValue(key, defaultValue, [&]() { return StorageMediumDecorator::readDouble(key, defaultValue); }); }
+    bool readBool(const String &key, const bool defaultValue) override { return readValue(key, defaultValue, [&]() { return StorageMediumDecorator::readBool(key, defaultValue); }); }
+    String readString(const String &key, const String defaultValue) override { return readValue(key, defaultValue, [&]() { return StorageMediumDecorator::readString(key, defaultValue); }); }
+
+    void writeChar(const String &key, const int8_t value) override { StorageMediumDecorator::writeChar(key, value); storeWritten(BatchEntry(key, &value)); }
+    void writeUChar(const String &key, const uint8_t value) override { StorageMediumDecorator::writeUChar(key, value); storeWritten(BatchEntry(key, &value)); }
+    void writeShort(const String &key, const int16_t value) override { StorageMediumDecorator::writeShort(key, value); storeWritten(BatchEntry(key, &value)); }
+    void writeUShort(const String &key, const uint16_t value) override { StorageMediumDecorator::writeUShort(key, value); storeWritten(BatchEntry(key, &value)); }
+    void writeInt(const String &key, const int32_t value) override { StorageMediumDecorator::writeInt(key, value); storeWritten(BatchEntry(key, &value)); }
+    void writeUInt(const String &key, const uint32_t value) override { StorageMediumDecorator::writeUInt(key, value); storeWritten(BatchEntry(key, &value)); }
+    void writeLong(const String &key, const int64_t value) override { StorageMediumDecorator::writeLong(key, value); storeWritten(BatchEntry(key, &value)); }
+    void writeULong(const String &key, const uint64_t value) override { StorageMediumDecorator::writeULong(key, value); storeWritten(BatchEntry(key, &value)); }
+    void writeFloat(const String &key, const float value) override { StorageMediumDecorator::writeFloat(key, value); storeWritten(BatchEntry(key, &value)); }
+    void writeDouble(const String &key, const double value) override { StorageMediumDecorator::writeDouble(key, value); storeWritten(BatchEntry(key, &value)); }
+    void writeBool(const String &key, const bool value) override { StorageMediumDecorator::writeBool(key, value); storeWritten(BatchEntry(key, &value)); }
+    void writeString(const String &key, const String value) override { StorageMediumDecorator::writeString(key, value); storeWritten(BatchEntry(key, &value)); }
+#pragma endregion
+
+    void readBatch(const BatchEntry *entries, const size_t count) override;
+    void writeBatch(const BatchEntry *entries, const size_t count) override;
+
+private:
+    enum class EntryKind : uint8_t
+    {
+        EXISTS,
+        COMPLETE,
+        BLOB,
+        VALUE,
+    };
+
+    /// @brief A file name or key, stored once however many entries use it, with the number of entries (and open files) that use it.
+    typedef std::map<String, size_t>::value_type Name;
+
+    /**
+     * @brief The names of an answer, `key` is `nullptr` for the answers about a file (existence, completeness, blob).
+     * Ordered by file first, so everything cached about a file is adjacent.
+     */
+    struct CacheKeyRef
+    {
+        const String *fileName;
+        EntryKind kind;
+        const String *key;
+    };
+
+    struct CacheKey
+    {
+        Name *fileName;
+        EntryKind kind;
+        Name *key;
+
+        operator CacheKeyRef() const { return {&fileName->first, kind, key != nullptr ? &key->first : nullptr}; }
+    };
+
+    /// @brief Compares the names, by address first, so keys can be looked up with names that are not interned.
+    struct CacheKeyOrder
+    {
+        typedef void is_transparent;
+
+        bool operator()(const CacheKeyRef &a, const CacheKeyRef &b) const;
+    };
+
+    struct CacheEntry
+    {
+        /// @brief The value of a key, or whether a file exists / is complete / has a blob in `found`.
+        StagedValue value;
+        /// @brief The default value the key was read with, the value is only reused for reads with the same default unless it is `stored`.
+        StagedValue defaultValue;
+        /// @brief Whether the value is known to be stored (it was written, or read and different from the default).
+        bool stored = false;
+        bool found = false;
+        /// @brief For completeness, the hash of the names of the parameters that were checked.
+        uint32_t parametersHash = 0;
+        std::vector<uint8_t> blob;
+        /// @brief The bytes counted for this entry in `usedBytes`.
+        size_t bytes = 0;
+        const CacheKey *key = nullptr;
+        /// @brief The neighbours in the recency order.
+        CacheEntry *newer = nullptr;
+        CacheEntry *older = nullptr;
+    };
+
+    const size_t capacity;
+    std::map<CacheKey, CacheEntry, CacheKeyOrder> entries;
+    /// @brief The file names and keys used by `entries`.
+    std::map<String, size_t> names;
+    /// @brief The most and least recently used entries.
+    CacheEntry *newest;
+    CacheEntry *oldest;
+    size_t usedBytes;
+    uint32_t hits;
+    uint32_t misses;
+
+    /// @brief The file open through this medium, or whose completeness is being read (`nullptr` if there is none).
+    Name *currentFile;
+    /// @brief Whether a file is open for reading through this medium, and whether it was opened on the inner medium yet.
+    bool readOpen;
+    bool innerOpen;
+
+    template <typename T, typename Func>
+    T readValue(const String &key, const T defaultValue, Func &&readInner)
+    {
+        T value = defaultValue;
+        if (lookupValue(currentFile->first, BatchEntry(key, &value)) || !openInner())
+            return value;
+        value = readInner();
+        storeRead(currentFile->first, BatchEntry(key, &value), StagedValue(BatchEntry(key, &defaultValue)));
+        return value;
+    }
+
+    CacheEntry *find(const String &fileName, const EntryKind kind, const String *key = nullptr);
+    /**
+     * @brief The entry for the answer, created if it is not cached, as the most recently used.
+     * Call `account` once it is filled in, which may evict it.
+     */
+    CacheEntry &insert(const String &fileName, const EntryKind kind, const String *key = nullptr);
+    void touch(CacheEntry &entry);
+    /**
+     * @brief Counts the bytes of `entry` and evicts the least recently used entries until the cache fits its capacity.
+     */
+    void account(CacheEntry &entry);
+    void erase(std::map<CacheKey, CacheEntry, CacheKeyOrder>::iterator it);
+    void forgetFile(const String &fileName);
+    void forget(const String &fileName, const EntryKind kind);
+
+    Name *intern(const String &name);
+    void release(Name *name);
+    void setCurrentFile(Name *file);
+
+    /**
+     * @brief Opens the file that is open for reading on the inner medium, if it was not yet.
+     */
+    bool openInner();
+
+    /**
+     * @brief Whether `fileName` exists, according to the cache.
+     *
+     * @return false if the cache does not know.
+     */
+    bool lookupExists(const String &fileName, bool &found);
+
+    /**
+     * @brief Whether the parameters' keys are stored in `fileName` (the current file, which exists), reading them from the inner medium
+     * in one batch and caching their values.
+     */
+    bool readComplete(const String &fileName, const std::vector<ParameterInfo> &parameters);
+
+    /**
+     * @brief Reads the value of `entry` in `fileName` from the cache into its variable, whose current value is the default value.
+     */
+    bool lookupValue(const String &fileName, const BatchEntry &entry);
+    void storeRead(const String &fileName, const BatchEntry &entry, const StagedValue &defaultValue);
+    void storeWritten(const BatchEntry &entry);
+    void storeFound(const String &fileName, const EntryKind kind, const bool found);
+};
+
+#endif // __H_CACHING_STORAGE_MEDIUM__
@@ -0,0 +1,504 @@
+#ifndef __H_CONFIGURATION_FIELDS__
+#define __H_CONFIGURATION_FIELDS__
+#include <WString.h>
+#include <array>
+#include <cfloat>
+#include <limits>
+#include <map>
+#include <stdexcept>
+#include <stdint.h>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include "ConfigurationUtils.h"
+#include "DataStructures.h"
+#include "StorageMedium.h"
+#include "internal/ParametersManager.h"
+#include "internal/TypedValue.h"
+#include "internal/ValidationResult.h"
+#include "internal/string-utils.h"
+
+/**
+ * @brief Declares the fields of a configuration struct `T`, from which `DeclaredConfigurationFunctions<T>` implements all of `ConfigurationFunctions<T>`.
+ *
+ * Specialize it with:
+ * - `static constexpr const char *title` - The configuration's title.
+ * - `static constexpr const char *fileName` - The name of the file in which the configuration is stored.
+ * - `static auto fields()` - A tuple of `configurationField(...)`, one per parameter (called once).
+ * - Optional: `static const ValidationResult validate(const T &configuration)` - Validates the fields together (e.g. one field depends on another).
+ *
+ * Then generate the functions with `CONFIGURATION_FUNCTIONS_FROM_FIELDS(T);`. Example:
+ * ```
+ * struct WifiConfig { String ssid; String password; uint16_t port = 80; bool dhcp = true; };
+ *
+ * template <>
+ * struct ConfigurationFields<WifiConfig>
+ * {
+ *     static constexpr const char *title = "Wi-Fi";
+ *     static constexpr const char *fileName = "/wifi.conf";
+ *     static auto fields()
+ *     {
+ *         return std::make_tuple(configurationField(&WifiConfig::ssid, stringParameter("ssid", ParameterAttribute::ATTR_NONE, 32)),
+ *                                configurationField(&WifiConfig::password, stringParameter("password", ParameterAttribute::ATTR_PASSWORD, 64)),
+ *                                configurationField(&WifiConfig::port, numericParameter("port", ParameterAttribute::ATTR_NONE, 1, 65535)),
+ *                                configurationField(&WifiConfig::dhcp, "dhcp"));
+ *     }
+ * };
+ * CONFIGURATION_FUNCTIONS_FROM_FIELDS(WifiConfig);
+ * ```
+ * The values of missing keys are the struct's default member values.
+ *
+ * @tparam T The type of the configuration object.
+ */
+template <typename T>
+struct ConfigurationFields;
+
+/**
+ * @brief A field of configuration struct `T` of type `M`, and the parameter that represents it.
+ */
+template <typename T, typename M>
+struct ConfigurationField
+{
+    M T::*member;
+    ParameterInfo info;
+};
+
+#pragma region Field value conversions
+/**
+ * @brief The parameter type of a field of type `M` (integers, floating point numbers, `bool` and `String` are supported).
+ */
+template <typename M>
+constexpr ParameterType fieldParameterType()
+{
+    static_assert(std::is_arithmetic<M>::value || std::is_same<M, String>::value, "Configuration fields must be numbers, bool or String");
+    if constexpr (std::is_same<M, bool>::value)
+        return ParameterType::TYPE_BOOL;
+    else if constexpr (std::is_integral<M>::value)
+        return ParameterType::TYPE_INT;
+    else if constexpr (std::is_floating_point<M>::value)
+        return ParameterType::TYPE_FLOAT;
+    else
+        return ParameterType::TYPE_STRING;
+}
+
+/**
+ * @brief Converts the text of a parameter's value into a field of type `M`.
+ *
+ * @return `false` if the text is not a valid `M` (`result` is not changed).
+ */
+template <typename M>
+bool parseFieldValue(const String &text, M *result)
+{
+    if constexpr (std::is_same<M, bool>::value)
+    {
+        if (!text.equalsIgnoreCase("true") && !text.equalsIgnoreCase("false"))
+            return false;
+        *result = text.equalsIgnoreCase("true");
+        return true;
+    }
+    else if constexpr (std::is_integral<M>::value && std::is_signed<M>::value)
+    {
+        int64_t value;
+        if (!tryParseInt64(text.c_str(), text.length(), &value) || value < std::numeric_limits<M>::min() || value > std::numeric_limits<M>::max())
+            return false;
+        *result = static_cast<M>(value);
+        return true;
+    }
+    else if constexpr (std::is_integral<M>::value)
+    {
+        uint64_t value;
+        if (!tryParseUInt64(text.c_str(), text.length(), &value) || value > std::numeric_limits<M>::max())
+            return false;
+        *result = static_cast<M>(value);
+        return true;
+    }
+    else if constexpr (std::is_floating_point<M>::value)
+    {
+        double value;
+        if (!tryParseDouble(text.c_str(), text.length(), &value))
+            return false;
+        *result = static_cast<M>(value);
+        return true;
+    }
+    else
+    {
+        *result = text;
+        return true;
+    }
+}
+
+/**
+ * @brief Converts a parameter's value into a field of type `M`, using the value's parsed form when it has the right kind.
+ */
+template <typename M>
+bool parseFieldValue(const String &text, const TypedValue &typed, M *result)
+{
+    if constexpr (std::is_same<M, bool>::value)
+    {
+        if (typed.getKind() == TypedValue::Kind::BOOL)
+        {
+            *result = typed.asBool();
+            return true;
+        }
+    }
+    else if constexpr (std::is_integral<M>::value && std::is_signed<M>::value)
+    {
+        if (typed.getKind() == TypedValue::Kind::INT)
+        {
+            if (typed.asInt() < std::numeric_limits<M>::min() || typed.asInt() > std::numeric_limits<M>::max())
+                return false;
+            *result = static_cast<M>(typed.asInt());
+            return true;
+        }
+    }
+    else if constexpr (std::is_floating_point<M>::value)
+    {
+        if (typed.getKind() == TypedValue::Kind::FLOAT)
+        {
+            *result = static_cast<M>(typed.asFloat());
+            return true;
+        }
+    }
+    return parseFieldValue(text, result);
+}
+
+/**
+ * @brief Converts a field of type `M` to the text of a parameter's value.
+ */
+template <typename M>
+String formatFieldValue(const M &value)
+{
+    if constexpr (std::is_same<M, bool>::value)
+        return value ? "true" : "false";
+    else if constexpr (std::is_same<M, float>::value)
+        return formatFloat(value);
+    else if constexpr (std::is_floating_point<M>::value)
+        return formatDouble(value);
+    else if constexpr (std::is_integral<M>::value && std::is_signed<M>::value)
+        return String(static_cast<long long>(value));
+    else if constexpr (std::is_integral<M>::value)
+        return String(static_cast<unsigned long long>(value));
+    else
+        return value;
+}
+#pragma endregion
+
+/**
+ * @brief Whether a parameter of type `type` can represent a field of type `M`.
+ * `String` fields can be represented by any parameter whose values are kept as text (strings, dates and options).
+ */
+template <typename M>
+constexpr bool isFieldParameterType(const ParameterType type)
+{
+    if constexpr (std::is_same<M, String>::value)
+        return type == ParameterType::TYPE_STRING || type == ParameterType::TYPE_DATE || type == ParameterType::TYPE_OPTIONSET;
+    else
+        return type == fieldParameterType<M>();
+}
+
+/**
+ * @brief Declare a field of a configuration struct, with the parameter that represents it (e.g. made with `numericParameter`).
+ *
+ * @throws std::invalid_argument If the parameter's type does not match the field's type (see `isFieldParameterType`).
+ */
+template <typename T, typename M>
+ConfigurationField<T, M> configurationField(M T::*member, const ParameterInfo &info)
+{
+    if (!isFieldParameterType<M>(info.type))
+        throw std::invalid_argument("The parameter's type does not match the field's type!");
+    return {member, info};
+}
+
+/**
+ * @brief Declare a field of a configuration struct, whose values are valid as long as they can be converted to the field's type.
+ */
+template <typename T, typename M>
+ConfigurationField<T, M> configurationField(M T::*member, const String &name, const ParameterAttribute attribute = ParameterAttribute::ATTR_NONE)
+{
+    Validator validator;
+    if constexpr (std::is_same<M, bool>::value)
+        validator = Validator::Boolean();
+    else if constexpr (std::is_integral<M>::value && std::is_signed<M>::value)
+        validator = Validator::IntRange(std::numeric_limits<M>::min(), std::numeric_limits<M>::max());
+    else if constexpr (std::is_integral<M>::value)
+        validator = Validator::UIntRange(0, std::numeric_limits<M>::max());
+    else if constexpr (std::is_same<M, float>::value)
+        validator = Validator::FloatRange(-FLT_MAX, FLT_MAX);
+    else if constexpr (std::is_floating_point<M>::value)
+        validator = Validator::DoubleRange(-DBL_MAX, DBL_MAX);
+    return {member, {name, fieldParameterType<M>(), attribute, validator}};
+}
+
+#pragma region Detection of optional ConfigurationFields members
+template <typename T, typename = void>
+struct HasObjectValidate : std::false_type
+{
+};
+template <typename T>
+struct HasObjectValidate<T, std::void_t<decltype(ConfigurationFields<T>::validate(std::declval<const T &>()))>> : std::true_type
+{
+};
+#pragma endregion
+
+/**
+ * @brief Implements `ConfigurationFunctions<T>` from the fields declared in `ConfigurationFields<T>`.
+ * All the fields are read or written in one batch (`FileHandler::readBatch`/`writeBatch`), and objects are loaded without going through a map of strings.
+ *
+ * @tparam T The type of the configuration object.
+ */
+template <typename T>
+struct DeclaredConfigurationFunctions
+{
+    static ConfigInfo getConfigInfo()
+    {
+        std::vector<ParameterInfo> parameters;
+        parameters.reserve(FIELDS_COUNT);
+        forEachField([&](const auto &field)
+                     { parameters.push_back(field.info); });
+        return {ConfigurationFields<T>::title, parameters};
+    }
+
+    static String getConfigFileName()
+    {
+        return ConfigurationFields<T>::fileName;
+    }
+
+    static std::vector<String> getOptionsFor(const String &parameterName)
+    {
+        std::vector<String> options;
+        forEachField([&](const auto &field)
+                     {
+                         if (field.info.name.equals(parameterName))
+                             options = field.info.isValid.fetchOptions(); });
+        return options;
+    }
+
+    static void save(const std::map<String, String> &values, StorageMedium::FileHandler &fileHandler)
+    {
+        FieldValues fieldValues = getDefaultValues(FieldIndices());
+        forEachField([&](const auto &field, auto &value)
+                     {
+                         const auto it = values.find(field.info.name);
+                         if (it != values.end())
+                             parseFieldValue(it->second, &value); },
+                     fieldValues);
+        writeValues(fieldValues, fileHandler, FieldIndices());
+    }
+
+    static void save(const ParameterValuesView &values, StorageMedium::FileHandler &fileHandler)
+    {
+        FieldValues fieldValues = getDefaultValues(FieldIndices());
+        forEachField([&](const auto &field, auto &value)
+                     {
+                         const auto it = values.find(field.info.name);
+                         if (it != values.end())
+                             parseFieldValue((*it).value, it.typed(), &value); },
+                     fieldValues);
+        writeValues(fieldValues, fileHandler, FieldIndices());
+    }
+
+    /**
+     * @brief Writes all the fields of `configuration`.
+     */
+    static void saveObject(const T &configuration, StorageMedium::FileHandler &fileHandler)
+    {
+        const auto entries = getObjectEntries(configuration, FieldIndices());
+        fileHandler.writeBatch(entries.data(), entries.size());
+    }
+
+    static std::map<String, String> loadAsMap(const StorageMedium::FileHandler &fileHandler)
+    {
+        FieldValues fieldValues = getDefaultValues(FieldIndices());
+        const auto entries = getValueEntries(fieldValues, FieldIndices());
+        fileHandler.readBatch(entries.data(), entries.size());
+        std::map<String, String> values;
+        forEachField([&](const auto &field, const auto &value)
+                     { values[field.info.name] = formatFieldValue(value); },
+                     fieldValues);
+        return values;
+    }
+
+    static T loadAsObject(const StorageMedium::FileHandler &fileHandler)
+    {
+        T configuration{};
+        const auto entries = getObjectEntries(configuration, FieldIndices());
+        fileHandler.readBatch(entries.data(), entries.size());
+        return configuration;
+    }
+
+    static const ValidationResult validate(const std::map<String, String> &values)
+    {
+        if constexpr (HasObjectValidate<T>::value)
+        {
+            T configuration{};
+            forEachField([&](const auto &field)
+                         {
+                             const auto it = values.find(field.info.name);
+                             if (it != values.end())
+                                 parseFieldValue(it->second, &(configuration.*field.member)); });
+            return ConfigurationFields<T>::validate(configuration);
+        }
+        else
+            return ValidationResult::Success();
+    }
+
+    static const ValidationResult validate(const ParameterValuesView &values)
+    {
+        if constexpr (HasObjectValidate<T>::value)
+            return ConfigurationFields<T>::validate(fromValues(values));
+        else
+            return ValidationResult::Success();
+    }
+
+#pragma region Packed storage
+    /**
+     * @brief The declared fields (a tuple of `ConfigurationField`), in order.
+     */
+    static const auto &getFieldDefinitions()
+    {
+        return getFields();
+    }
+
+    /**
+     * @brief Batch entries for all the fields of `configuration`, in the order of the fields (used to pack it into a single blob).
+     * Entries made from a `const T` can only be written.
+     */
+    static auto getEntries(T &configuration)
+    {
+        return getObjectEntries(configuration, FieldIndices());
+    }
+    static auto getEntries(const T &configuration)
+    {
+        return getObjectEntries(configuration, FieldIndices());
+    }
+
+    /**
+     * @brief Builds a configuration object from parameters' values, missing and invalid values are left at their defaults.
+     */
+    static T fromValues(const ParameterValuesView &values)
+    {
+        T configuration{};
+        forEachField([&](const auto &field)
+                     {
+                         const auto it = values.find(field.info.name);
+                         if (it != values.end())
+                             parseFieldValue((*it).value, it.typed(), &(configuration.*field.member)); });
+        return configuration;
+    }
+
+    /**
+     * @brief The parameters' values of `configuration`, as returned by `loadAsMap`.
+     */
+    static std::map<String, String> toMap(const T &configuration)
+    {
+        std::map<String, String> values;
+        forEachField([&](const auto &field)
+                     { values[field.info.name] = formatFieldValue(configuration.*field.member); });
+        return values;
+    }
+#pragma endregion
+
+private:
+    /**
+     * @brief The declared fields, built once.
+     */
+    static const auto &getFields()
+    {
+        static const auto fields = ConfigurationFields<T>::fields();
+        return fields;
+    }
+
+    typedef std::decay_t<decltype(ConfigurationFields<T>::fields())> Fields;
+    static constexpr size_t FIELDS_COUNT = std::tuple_size<Fields>::value;
+    static_assert(FIELDS_COUNT > 0, "A configuration must declare at least one field");
+    typedef std::make_index_sequence<FIELDS_COUNT> FieldIndices;
+
+    /**
+     * @brief A tuple with a value for every field, in the order of the fields.
+     */
+    template <typename Field>
+    struct FieldValueType;
+    template <typename M>
+    struct FieldValueType<ConfigurationField<T, M>>
+    {
+        typedef M type;
+    };
+    template <size_t... I>
+    static std::tuple<typename FieldValueType<std::tuple_element_t<I, Fields>>::type...> fieldValuesOf(std::index_sequence<I...>);
+    typedef decltype(fieldValuesOf(FieldIndices())) FieldValues;
+
+    /**
+     * @brief The default values of the fields, used for missing keys and invalid values.
+     */
+    static const T &getDefaults()
+    {
+        static const T defaults{};
+        return defaults;
+    }
+
+    template <size_t... I>
+    static FieldValues getDefaultValues(std::index_sequence<I...>)
+    {
+        return FieldValues(getDefaults().*std::get<I>(getFields()).member...);
+    }
+
+    /**
+     * @brief Batch entries for the fields of `configuration` (`T` or `const T`, for writing only).
+     */
+    template <typename Configuration, size_t... I>
+    static std::array<StorageMedium::BatchEntry, FIELDS_COUNT> getObjectEntries(Configuration &configuration, std::index_sequence<I...>)
+    {
+        return {StorageMedium::BatchEntry(std::get<I>(getFields()).info.name, &(configuration.*std::get<I>(getFields()).member))...};
+    }
+
+    /**
+     * @brief Batch entries for values held outside of a configuration object.
+     */
+    template <size_t... I>
+    static std::array<StorageMedium::BatchEntry, FIELDS_COUNT> getValueEntries(FieldValues &values, std::index_sequence<I...>)
+    {
+        return {StorageMedium::BatchEntry(std::get<I>(getFields()).info.name, &std::get<I>(values))...};
+    }
+
+    template <size_t... I>
+    static void writeValues(FieldValues &values, StorageMedium::FileHandler &fileHandler, std::index_sequence<I...> indices)
+    {
+        const auto entries = getValueEntries(values, indices);
+        fileHandler.writeBatch(entries.data(), entries.size());
+    }
+
+    template <typename Func>
+    static void forEachField(Func &&func)
+    {
+        std::apply([&](const auto &...field)
+                   { (func(field), ...); },
+                   getFields());
+    }
+
+    /**
+     * @brief Calls `func` with every field and its value in `values`.
+     */
+    template <typename Func, typename Values>
+    static void forEachField(Func &&func, Values &values)
+    {
+        forEachFieldValue(func, values, FieldIndices());
+    }
+
+    template <typename Func, typename Values, size_t... I>
+    static void forEachFieldValue(Func &func, Values &values, std::index_sequence<I...>)
+    {
+        (func(std::get<I>(getFields()), std::get<I>(values)), ...);
+    }
+};
+
+/**
+ * @brief Implements `ConfigurationFunctions<T>` from the fields declared in `ConfigurationFields<T>` (see `ConfigurationFields`).
+ */
+#define CONFIGURATION_FUNCTIONS_FROM_FIELDS(T)                             \
+    template <>                                                            \
+    struct ConfigurationFunctions<T> : DeclaredConfigurationFunctions<T> \
+    {                                                                      \
+    }
+
+#endif // __H_CONFIGURATION_FIELDS__
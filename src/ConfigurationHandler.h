@@ -9,8 +9,80 @@
 #include "DataStructures.h"
 #include "InputInterface.h"
 #include "StorageMedium.h"
+#include "internal/Journal.h"
+#include "internal/Manifest.h"
+#include "internal/PackedConfiguration.h"
 #include "internal/ParametersManager.h"
 
+/**
+ * @brief How the configurations are stored in the storage medium.
+ */
+enum class StorageEncoding : uint8_t
+{
+    /// @brief Every parameter is stored in its own key.
+    KEYS,
+    /// @brief Each configuration is stored as a single packed blob (see `PackedConfiguration`), with a schema hash and a checksum.
+    /// Applies to configurations that support it (see `IsPackable`, e.g. declared with `ConfigurationFields`) on mediums that support blobs,
+    /// the others are stored in keys. When the blob is missing, stale or corrupt, the configuration is read from its keys,
+    /// which only exist if it was last saved in keys (writing the blob deletes them).
+    PACKED,
+};
+
+/**
+ * @brief How `ConfigurationHandler::saveConfiguration` writes the configurations.
+ */
+enum class SaveMode : uint8_t
+{
+    /// @brief Each configuration is written in turn, a reset partway through can leave some configurations new and others old (or half-written).
+    DIRECT,
+    /// @brief The writes of all the configurations are staged in a journal that is committed with a single blob write, and then performed,
+    /// so after a reset either all of them or none of them are applied (see `ConfigurationHandler::recoverJournal`). Requires a medium that supports blobs.
+    JOURNALED,
+};
+
+/**
+ * @brief What `ConfigurationHandler::recoverJournal` found in the storage medium.
+ */
+enum class JournalRecovery : uint8_t
+{
+    /// @brief There was no journal, the last save completed.
+    NONE,
+    /// @brief A committed save was interrupted, its writes were performed again.
+    REPLAYED,
+    /// @brief The journal was cut short before it was committed, it was deleted and the configurations are as before that save.
+    DISCARDED,
+};
+
+/**
+ * @brief How `ConfigurationHandler::configsExist` and `ConfigurationHandler::configsAreComplete` find out about the stored configurations.
+ */
+enum class ConfigurationIndex : uint8_t
+{
+    /// @brief The file (or blob) of every configuration is checked.
+    NONE,
+    /// @brief A manifest (see `Manifest`), updated by `saveConfiguration` and `deleteConfigurations`, answers for all the configurations with a single blob read.
+    /// Configurations it has no up-to-date entry for (never saved by the handler, or saved with other parameters) are checked in their files.
+    /// Files changed without the handler (e.g. with `createFileHandler`) must be recorded with `ConfigurationHandler::refreshManifest`.
+    /// With `SaveMode::DIRECT` a reset during a save can leave a half-written file recorded as complete, use `SaveMode::JOURNALED` to avoid it.
+    /// Requires a medium that supports blobs, otherwise the files are always checked.
+    MANIFEST,
+};
+
+/**
+ * @brief The result of `ConfigurationHandler::checkBoot`.
+ */
+enum class BootStatus : uint8_t
+{
+    /// @brief A configuration has no file.
+    MISSING,
+    /// @brief A configuration's file does not hold all its parameters.
+    INCOMPLETE,
+    /// @brief A configuration holds invalid values.
+    INVALID,
+    /// @brief All the configurations are complete and valid.
+    READY,
+};
+
 /**
  * @brief A mediator between configuration types and the StorageMedium.
  * It abstracts the complexity of interacting with the storage medium for configurations by providing functions for specific configuration operations,
@@ -20,8 +92,32 @@
 class ConfigurationHandler
 {
 public:
-    ConfigurationHandler(StorageMedium &storageMedium)
-        : storageMedium(storageMedium) {}
+    ConfigurationHandler(StorageMedium &storageMedium, const StorageEncoding encoding = StorageEncoding::KEYS, const SaveMode saveMode = SaveMode::DIRECT,
+                         const ConfigurationIndex index = ConfigurationIndex::NONE)
+        : storageMedium(storageMedium), encoding(encoding), saveMode(saveMode), index(index) {}
+
+    /**
+     * @brief Completes or rolls back a journaled save that was interrupted (see `SaveMode::JOURNALED`).
+     *
+     * Call it at boot, before loading the configurations. A committed journal is replayed, a journal that was cut short is discarded.
+     *
+     * @return JournalRecovery - What was found in the storage medium.
+     */
+    JournalRecovery recoverJournal()
+    {
+        std::vector<uint8_t> blob;
+        if (!storageMedium.readBlob(Journal::FILE_NAME, blob))
+            return JournalRecovery::NONE;
+        Journal journal;
+        if (!journal.decode(blob))
+        {
+            storageMedium.deleteBlob(Journal::FILE_NAME);
+            return JournalRecovery::DISCARDED;
+        }
+        journal.apply(storageMedium);
+        storageMedium.deleteBlob(Journal::FILE_NAME);
+        return JournalRecovery::REPLAYED;
+    }
 
     /**
      * @brief Checks if all the provided configurations have a configuration file in the storage medium.
@@ -33,7 +129,8 @@ public:
     template <typename... ConfigurationTypes>
     bool configsExist()
     {
-        return (configurationExists<ConfigurationTypes>() && ...);
+        const std::optional<Manifest> manifest = loadManifest();
+        return (configurationExists<ConfigurationTypes>(manifest) && ...);
     }
 
     /**
@@ -48,7 +145,74 @@ public:
     template <typename... ConfigurationTypes>
     bool configsAreComplete()
     {
-        return (configurationIsComplete<ConfigurationTypes>() && ...);
+        const std::optional<Manifest> manifest = loadManifest();
+        return (configurationIsComplete<ConfigurationTypes>(manifest) && ...);
+    }
+
+    /**
+     * @brief Checks at boot that all the provided configurations exist, are complete and hold valid values:
+     * `configsExist`, `configsAreComplete` and `validateConfigurations(ChainedValidationResults::FAIL_FAST)` in one pass,
+     * and loads them like `loadConfigurations`, so they do not have to be read again.
+     *
+     * With `ConfigurationIndex::MANIFEST`, a configuration whose loaded values match the fingerprint recorded when they were saved
+     * (a hash of the stored values, validated against the current schema) is ready without probing its file or validating it again.
+     * The other configurations are checked in full and what was found is recorded, with the fingerprint of those that pass for the next boot.
+     * Only the keys that are stored are part of the loaded fingerprint, so a key that went missing is found by the full check.
+     * The bounds of the built-in validators are part of the schema, but validation functions (and the providers of option sets) are not:
+     * after changing one, call `refreshManifest` so the values are validated again.
+     *
+     * Example usage: `std::tuple<std::optional<Config1>, std::optional<Config2>> configurations;`
+     * `if (confHandler.checkBoot(configurations) == BootStatus::READY) {...}`
+     *
+     * @tparam ConfigurationTypes - The type of the configurations you want to check.
+     * @param configurations - Receives the loaded configurations. The ones after the first configuration that is not ready are not loaded.
+     * @return BootStatus - `BootStatus::READY`, or what is wrong with the first configuration that is not ready.
+     */
+    template <typename... ConfigurationTypes>
+    BootStatus checkBoot(std::tuple<std::optional<ConfigurationTypes>...> &configurations)
+    {
+        ParametersManager parametersManager;
+        const std::optional<Manifest> manifest = loadManifest();
+        Manifest updated = manifest.value_or(Manifest());
+        bool changed = false;
+        BootStatus status = BootStatus::READY;
+        std::apply([&](std::optional<ConfigurationTypes> &...configuration)
+                   {
+                       // Stops at the first configuration that is not ready.
+                       (((status = checkBootType<ConfigurationTypes>(configuration, parametersManager, manifest, updated, changed)) == BootStatus::READY) && ...);
+                   },
+                   configurations);
+        if (changed)
+            writeManifest(manifest, updated, true, storageMedium);
+        return status;
+    }
+
+    /**
+     * @brief `checkBoot`, for a sketch that loads the configurations later.
+     */
+    template <typename... ConfigurationTypes>
+    BootStatus checkBoot()
+    {
+        std::tuple<std::optional<ConfigurationTypes>...> configurations;
+        return checkBoot(configurations);
+    }
+
+    /**
+     * @brief Checks the files of the given configuration types and records what was found in the manifest (see `ConfigurationIndex::MANIFEST`),
+     * without fingerprints, so `checkBoot` validates them again.
+     * Call it after changing configuration files without the handler, or after changing a validation function or an option provider. Does nothing without a manifest.
+     *
+     * @tparam ConfigurationTypes - The configuration types whose entries are recorded again.
+     */
+    template <typename... ConfigurationTypes>
+    void refreshManifest()
+    {
+        if (index != ConfigurationIndex::MANIFEST)
+            return;
+        std::optional<Manifest> manifest = loadManifest();
+        Manifest updated = manifest.value_or(Manifest());
+        const bool changed = (updated.set(getConfigurationFileName<ConfigurationTypes>(), probeEntry<ConfigurationTypes>()) | ...);
+        writeManifest(manifest, updated, changed, storageMedium);
     }
 
     /**
@@ -61,7 +225,7 @@ public:
     template <typename ConfigurationType>
     StorageMedium::FileHandler createFileHandler(const FileMode fileMode)
     {
-        const String fileName = getConfigurationFileName<ConfigurationType>();
+        const String &fileName = getConfigurationFileName<ConfigurationType>();
         return storageMedium.createFileHandler(fileName, fileMode);
     }
 
@@ -74,18 +238,18 @@ public:
     template <typename ConfigurationType>
     std::optional<ConfigurationType> loadConfiguration()
     {
-        if (!configurationExists<ConfigurationType>())
-            return std::nullopt;
-
-        // Open file for read
-        StorageMedium::FileHandler fileHandler = createFileHandler<ConfigurationType>(FileMode::READ);
-        if (!fileHandler)
+        if constexpr (IsPackable<ConfigurationType>::value)
         {
-            // Failed to open the file even though it exists.
-            const String fileName = getConfigurationFileName<ConfigurationType>();
-            Serial.printf("Error opening file: \"%s\"\n", fileName);
-            throw std::runtime_error("Error opening file!");
+            // One read and a checksum instead of one read per parameter.
+            ConfigurationType configuration{};
+            if (loadPacked(configuration))
+                return configuration;
         }
+
+        // Open file for read, checking that it exists in the same access.
+        StorageMedium::FileHandler fileHandler = openIfExists<ConfigurationType>();
+        if (!fileHandler.isFound())
+            return std::nullopt;
         // Read the data from the file.
         return ConfigurationFunctions<ConfigurationType>::loadAsObject(fileHandler);
     }
@@ -106,6 +270,25 @@ public:
         return std::make_tuple(loadConfiguration<ConfigurationTypes>()...);
     }
 
+    /**
+     * @brief Validates the stored values of the given configuration types: each parameter's value, then each configuration as a whole.
+     * The configurations are loaded and validated one after the other, and the process stops as soon as `maxErrors` errors were found.
+     *
+     * Example usage (boot-time check): `if (confHandler.validateConfigurations<Config1, Config2>(ChainedValidationResults::FAIL_FAST).isFailure()) {...}`
+     *
+     * @tparam ConfigurationTypes - The types of configurations you want to validate.
+     * @param maxErrors - Stop after that many errors, or `ChainedValidationResults::UNBOUNDED` to validate everything.
+     * @return ChainedValidationResults - The errors that were found.
+     */
+    template <typename... ConfigurationTypes>
+    ChainedValidationResults validateConfigurations(const size_t maxErrors = ChainedValidationResults::UNBOUNDED)
+    {
+        ParametersManager parametersManager;
+        ChainedValidationResults result = ChainedValidationResults::WithMaxErrors(maxErrors);
+        (appendStoredValidation<ConfigurationTypes>(parametersManager, result) || ...);
+        return result;
+    }
+
     /**
      * @brief Deletes the configuration files for each configuration type from the storage medium.
      *
@@ -118,6 +301,8 @@ public:
     template <typename... ConfigurationTypes>
     std::array<bool, sizeof...(ConfigurationTypes)> deleteConfigurations()
     {
+        // Recorded as missing first, so a reset between the two never leaves a deleted configuration reported present.
+        recordDeleted<ConfigurationTypes...>();
         return {deleteConfiguration<ConfigurationTypes>()...};
     }
 
@@ -126,6 +311,7 @@ public:
      * and passes them to the input interface.
      * 
      * Then it starts the input interface and blocks until the input interface finishes.
+     * When validating the input, a configuration type is validated again only if the values of its parameters changed since its last validation.
      *
      * @tparam ConfigurationTypes - The configuration types you wish to load onto the input interface.
      */
@@ -136,79 +322,443 @@ public:
         ParametersManager parametersManager;
         // Read all parameters and their values from all configuration types.
         (loadConfigParameters<ConfigurationTypes>(parametersManager), ...);
-        inputInterface.initialize(&parametersManager, [this, &parametersManager]()
+        // The last validation result of each type, so only the types whose values changed are validated again.
+        std::array<CachedValidation, sizeof...(ConfigurationTypes)> validations;
+        inputInterface.initialize(&parametersManager, [this, &parametersManager, &validations](const size_t maxErrors)
                                   {
-             ChainedValidationResults result = parametersManager.validateAllValues();
+             ChainedValidationResults result = parametersManager.validateAllValues(maxErrors);
  // No need to run validation on the types with invalid values that must be changed anyway.
  if (result.isSuccess())
-     // Append all the results to one object.
-     ((result = result && validateType<ConfigurationTypes>(parametersManager)), ...);
+ {
+     // Append all the results to one object, until it is full.
+     size_t typeIndex = 0;
+     (appendTypeValidation<ConfigurationTypes>(parametersManager, validations[typeIndex++], result) || ...);
+ }
  return result; }, [this, &parametersManager]()
                                   { saveConfiguration<ConfigurationTypes...>(parametersManager); });
 
-        (inputInterface.registerConfiguration(ConfigurationFunctions<ConfigurationTypes>::getConfigInfo()), ...);
+        (inputInterface.registerConfiguration(ConfigurationSchema<ConfigurationTypes>::getInfo()), ...);
         inputInterface.start();
     }
 
     /**
      * @brief Writes the values of each parameter into the appropriate config file in the storage medium.
      *
+     * Only what was changed is written: configurations whose file is complete and whose parameters were not modified are skipped,
+     * and, on mediums that support `FileMode::UPDATE`, for the other complete files only the modified parameters are written.
+     * Files that are missing or incomplete, configurations whose parameters were all modified, and modified configurations on other mediums are rewritten in full.
+     * With `SaveMode::JOURNALED`, the same writes are staged and committed together, so a reset applies all of them or none.
+     * With `ConfigurationIndex::MANIFEST`, the manifest is updated after the configurations (in the same journal when journaled),
+     * with each configuration's fingerprint for `checkBoot`: the hash of its values, and whether they passed validation.
+     * A direct save first records the configurations it writes as missing, so a reset before it ends never leaves a half-written configuration recorded as present.
+     *
      * @tparam ConfigurationTypes
      * @param paramsManager - An object containing the values for all the parameters.
      */
     template <typename... ConfigurationTypes>
     void saveConfiguration(ParametersManager &paramsManager)
     {
-        (saveConfig<ConfigurationTypes>(paramsManager), ...);
+        if (saveMode == SaveMode::DIRECT)
+        {
+            const std::optional<Manifest> manifest = loadManifest();
+            const std::array<SaveScope, sizeof...(ConfigurationTypes)> scopes = {getSaveScope<ConfigurationTypes>(paramsManager, storageMedium, manifest)...};
+            // The files are written one after the other, the ones being written are recorded as missing until they all are,
+            // so a reset in between never leaves a configuration with old and new values recorded as present.
+            const std::optional<Manifest> recorded = recordSaving<ConfigurationTypes...>(manifest, scopes);
+            size_t typeIndex = 0;
+            (saveConfig<ConfigurationTypes>(paramsManager, storageMedium, scopes[typeIndex++]), ...);
+            recordSaved<ConfigurationTypes...>(paramsManager, recorded, storageMedium);
+            return;
+        }
+
+        // The files (and the manifest) must be up to date before deciding what to write.
+        recoverJournal();
+        const std::optional<Manifest> manifest = loadManifest();
+        Journal journal;
+        JournalingStorageMedium staging(storageMedium, journal);
+        (saveConfig<ConfigurationTypes>(paramsManager, staging, getSaveScope<ConfigurationTypes>(paramsManager, staging, manifest)), ...);
+        recordSaved<ConfigurationTypes...>(paramsManager, manifest, staging);
+        commitJournal(journal);
     }
 
 private:
     StorageMedium &storageMedium;
+    const StorageEncoding encoding;
+    const SaveMode saveMode;
+    const ConfigurationIndex index;
+
+    /**
+     * @brief What a save writes for a configuration.
+     */
+    enum class SaveScope : uint8_t
+    {
+        /// @brief Nothing, its file is complete and none of its parameters were modified.
+        NONE,
+        /// @brief Only the modified parameters, its file is complete and the medium can update keys in place.
+        MODIFIED,
+        /// @brief All the parameters.
+        ALL,
+    };
+
+    /**
+     * @brief The result of validating a configuration type, valid as long as the revision of its category did not change.
+     */
+    struct CachedValidation
+    {
+        uint32_t revision = 0;
+        std::optional<ValidationResult> result;
+    };
 
     template <typename T>
     const ValidationResult validateType(ParametersManager &paramsManager)
     {
-        ConfigInfo info = ConfigurationFunctions<T>::getConfigInfo();
-        const std::map<String, String> t = paramsManager.getParametersValues(info.title);
-        return ConfigurationFunctions<T>::validate(t);
+        const ConfigInfo &info = ConfigurationSchema<T>::getInfo();
+        return validateConfigurationValues<T>(paramsManager.getParametersView(info.title));
+    }
+
+    template <typename T>
+    const ValidationResult validateTypeCached(ParametersManager &paramsManager, CachedValidation &cache)
+    {
+        const uint32_t revision = paramsManager.getRevision(ConfigurationSchema<T>::getInfo().title);
+        if (!cache.result.has_value() || cache.revision != revision)
+        {
+            cache.result = validateType<T>(paramsManager);
+            cache.revision = revision;
+        }
+        return cache.result.value();
+    }
+
+    /**
+     * @brief Appends the validation result of type `T` to `results`.
+     *
+     * @return Whether `results` is full, so the remaining types do not need to be validated.
+     */
+    template <typename T>
+    bool appendTypeValidation(ParametersManager &paramsManager, CachedValidation &cache, ChainedValidationResults &results)
+    {
+        results && validateTypeCached<T>(paramsManager, cache);
+        return results.isFull();
+    }
+
+    /**
+     * @brief Loads the stored values of type `T` and appends the validation results of its parameters, and then of the whole configuration, to `results`.
+     *
+     * @return Whether `results` is full, so the remaining types do not need to be validated.
+     */
+    template <typename T>
+    bool appendStoredValidation(ParametersManager &paramsManager, ChainedValidationResults &results)
+    {
+        loadConfigParameters<T>(paramsManager);
+        return appendValuesValidation<T>(paramsManager, results);
+    }
+
+    /**
+     * @brief Appends the validation results of the parameters of type `T` in `paramsManager`, and then of the whole configuration, to `results`.
+     *
+     * @return Whether `results` is full.
+     */
+    template <typename T>
+    bool appendValuesValidation(ParametersManager &paramsManager, ChainedValidationResults &results)
+    {
+        const size_t previousErrors = results.getFailures().size();
+        for (const ParametersManager::ParameterHandle handle : paramsManager.getCategoryParameters(ConfigurationSchema<T>::getInfo().title))
+        {
+            results && paramsManager.validateValue(handle, paramsManager.getValue(handle));
+            if (results.isFull())
+                return true;
+        }
+        // No need to run validation on a type with invalid values.
+        if (results.getFailures().size() == previousErrors)
+            results && validateType<T>(paramsManager);
+        return results.isFull();
+    }
+
+    /**
+     * @brief Loads `configuration` from its packed blob, when the configuration is stored packed.
+     *
+     * @return Whether the blob exists and matches the configuration's current fields.
+     */
+    template <typename ConfigurationType>
+    bool loadPacked(ConfigurationType &configuration)
+    {
+        if (encoding != StorageEncoding::PACKED)
+            return false;
+        std::vector<uint8_t> blob;
+        if (!storageMedium.readBlob(getConfigurationFileName<ConfigurationType>(), blob))
+            return false;
+        const auto entries = ConfigurationFunctions<ConfigurationType>::getEntries(configuration);
+        return PackedConfiguration::decode(blob, entries.data(), entries.size()) == PackedConfiguration::DecodeResult::OK;
+    }
+
+    /**
+     * @brief Whether the configuration has a valid packed blob (loading it to check).
+     */
+    template <typename ConfigurationType>
+    bool packedIsValid()
+    {
+        if constexpr (IsPackable<ConfigurationType>::value)
+        {
+            ConfigurationType configuration{};
+            return loadPacked(configuration);
+        }
+        else
+            return false;
+    }
+
+    /**
+     * @return The manifest, `std::nullopt` without a manifest, or if it is missing or corrupt.
+     */
+    std::optional<Manifest> loadManifest()
+    {
+        if (index != ConfigurationIndex::MANIFEST)
+            return std::nullopt;
+        std::vector<uint8_t> blob;
+        Manifest manifest;
+        if (!storageMedium.readBlob(Manifest::FILE_NAME, blob) || !manifest.decode(blob))
+            return std::nullopt;
+        return manifest;
+    }
+
+    /**
+     * @return The manifest's entry for the configuration, `nullptr` if there is none or it was recorded with other parameters.
+     */
+    template <typename ConfigurationType>
+    const Manifest::Entry *findManifestEntry(const std::optional<Manifest> &manifest)
+    {
+        if (!manifest.has_value())
+            return nullptr;
+        const Manifest::Entry *entry = manifest->find(getConfigurationFileName<ConfigurationType>());
+        if (entry == nullptr || entry->schemaVersion != Manifest::hashSchema(ConfigurationSchema<ConfigurationType>::getInfo().parameters))
+            return nullptr;
+        return entry;
+    }
+
+    /**
+     * @brief Writes `updated` to `target` if it `changed` from `manifest`, or if there was no valid manifest.
+     */
+    void writeManifest(const std::optional<Manifest> &manifest, const Manifest &updated, const bool changed, StorageMedium &target)
+    {
+        // On a medium without blobs the write fails, and the files are checked instead.
+        if (changed || !manifest.has_value())
+            target.writeBlob(Manifest::FILE_NAME, updated.encode());
+    }
+
+    /**
+     * @brief Records the given configurations as saved in full in the manifest, with their fingerprints, writing it to `target`.
+     */
+    template <typename... ConfigurationTypes>
+    void recordSaved(ParametersManager &paramsManager, const std::optional<Manifest> &manifest, StorageMedium &target)
+    {
+        if (index != ConfigurationIndex::MANIFEST)
+            return;
+        Manifest updated = manifest.value_or(Manifest());
+        const bool changed = (updated.set(getConfigurationFileName<ConfigurationTypes>(), savedEntry<ConfigurationTypes>(paramsManager)) | ...);
+        writeManifest(manifest, updated, changed, target);
+    }
+
+    /**
+     * @brief Before a direct save, records the configurations it writes as missing in the manifest, like `recordDeleted`.
+     *
+     * @return The manifest as it is now stored.
+     */
+    template <typename... ConfigurationTypes>
+    std::optional<Manifest> recordSaving(const std::optional<Manifest> &manifest, const std::array<SaveScope, sizeof...(ConfigurationTypes)> &scopes)
+    {
+        // Without a manifest, the files are checked anyway.
+        if (!manifest.has_value())
+            return manifest;
+        Manifest updated = manifest.value();
+        bool changed = false;
+        size_t typeIndex = 0;
+        ((changed = (scopes[typeIndex++] != SaveScope::NONE &&
+                     updated.set(getConfigurationFileName<ConfigurationTypes>(), Manifest::makeEntry(ConfigurationSchema<ConfigurationTypes>::getInfo().parameters, false))) ||
+                    changed),
+         ...);
+        if (!changed)
+            return manifest;
+        writeManifest(manifest, updated, changed, storageMedium);
+        return updated;
+    }
+
+    template <typename... ConfigurationTypes>
+    void recordDeleted()
+    {
+        if (index != ConfigurationIndex::MANIFEST)
+            return;
+        const std::optional<Manifest> manifest = loadManifest();
+        Manifest updated = manifest.value_or(Manifest());
+        const bool changed = (updated.set(getConfigurationFileName<ConfigurationTypes>(),
+                                          Manifest::makeEntry(ConfigurationSchema<ConfigurationTypes>::getInfo().parameters, false)) |
+                              ...);
+        writeManifest(manifest, updated, changed, storageMedium);
+    }
+
+    /**
+     * @brief The manifest entry of a configuration saved from `paramsManager`. Its values are validated (in RAM) so `checkBoot` does not have to.
+     */
+    template <typename ConfigurationType>
+    Manifest::Entry savedEntry(ParametersManager &paramsManager)
+    {
+        const ConfigInfo &info = ConfigurationSchema<ConfigurationType>::getInfo();
+        Manifest::Entry entry = Manifest::makeEntry(info.parameters, true);
+        entry.contentHash = fingerprintValues<ConfigurationType>(paramsManager.getParametersView(info.title));
+        ChainedValidationResults results = ChainedValidationResults::WithMaxErrors(ChainedValidationResults::FAIL_FAST);
+        if (!appendValuesValidation<ConfigurationType>(paramsManager, results))
+            entry.validatedSchema = entry.schemaVersion;
+        return entry;
+    }
+
+    /**
+     * @brief The fingerprint of `values` as a save stores them, which is the one `loadFingerprinted` finds when it loads them back.
+     */
+    template <typename ConfigurationType>
+    uint32_t fingerprintValues(const ParameterValuesView &values)
+    {
+        Fingerprint fingerprint;
+        if constexpr (IsPackable<ConfigurationType>::value)
+        {
+            ConfigurationType configuration = ConfigurationFunctions<ConfigurationType>::fromValues(values);
+            fingerprint.addAll(ConfigurationFunctions<ConfigurationType>::getEntries(configuration));
+        }
+        else
+        {
+            // The save writes to a medium that only hashes the values.
+            FingerprintingStorageMedium hashing(storageMedium, fingerprint);
+            StorageMedium::FileHandler fileHandler = hashing.createFileHandler(getConfigurationFileName<ConfigurationType>(), FileMode::WRITE);
+            saveConfigurationValues<ConfigurationType>(values, fileHandler);
+        }
+        return fingerprint.get();
+    }
+
+    /**
+     * @brief Loads the configuration like `loadConfiguration`, and the fingerprint of the loaded values into `contentHash`.
+     */
+    template <typename ConfigurationType>
+    std::optional<ConfigurationType> loadFingerprinted(uint32_t &contentHash)
+    {
+        Fingerprint fingerprint;
+        std::optional<ConfigurationType> configuration;
+        if constexpr (IsPackable<ConfigurationType>::value)
+        {
+            // A blob that matches the schema holds all the fields.
+            ConfigurationType packed{};
+            if (loadPacked(packed))
+            {
+                fingerprint.addAll(ConfigurationFunctions<ConfigurationType>::getEntries(packed));
+                contentHash = fingerprint.get();
+                return packed;
+            }
+        }
+        // Only the keys that are stored are hashed, so a missing key does not match the fingerprint of a save.
+        FingerprintingStorageMedium hashing(storageMedium, fingerprint);
+        StorageMedium::FileHandler fileHandler = openIfExists<ConfigurationType>(hashing);
+        if (fileHandler.isFound())
+            configuration = ConfigurationFunctions<ConfigurationType>::loadAsObject(fileHandler);
+        contentHash = fingerprint.get();
+        return configuration;
+    }
+
+    /**
+     * @brief Loads a configuration into `configuration` and checks it for `checkBoot`, recording its fingerprint in `updated` when it passes a full check.
+     */
+    template <typename ConfigurationType>
+    BootStatus checkBootType(std::optional<ConfigurationType> &configuration, ParametersManager &paramsManager, const std::optional<Manifest> &manifest,
+                             Manifest &updated, bool &changed)
+    {
+        const ConfigInfo &info = ConfigurationSchema<ConfigurationType>::getInfo();
+        uint32_t contentHash;
+        configuration = loadFingerprinted<ConfigurationType>(contentHash);
+        const Manifest::Entry *entry = findManifestEntry<ConfigurationType>(manifest);
+        if (configuration.has_value() && entry != nullptr && entry->present && entry->complete && entry->validatedSchema == entry->schemaVersion &&
+            entry->contentHash == contentHash)
+            return BootStatus::READY;
+
+        // The values are not the ones that were validated, check everything and record what was found.
+        Manifest::Entry checked = Manifest::makeEntry(info.parameters, true);
+        BootStatus status = BootStatus::READY;
+        ChainedValidationResults results = ChainedValidationResults::WithMaxErrors(ChainedValidationResults::FAIL_FAST);
+        // The configuration loads if and only if it exists.
+        if (!configuration.has_value())
+        {
+            checked = Manifest::makeEntry(info.parameters, false);
+            status = BootStatus::MISSING;
+        }
+        else if (!configurationIsComplete<ConfigurationType>(std::nullopt))
+        {
+            checked.complete = false;
+            status = BootStatus::INCOMPLETE;
+        }
+        else if (appendStoredValidation<ConfigurationType>(paramsManager, results))
+            status = BootStatus::INVALID;
+        else
+        {
+            checked.contentHash = contentHash;
+            checked.validatedSchema = checked.schemaVersion;
+        }
+        if (index == ConfigurationIndex::MANIFEST)
+            changed = updated.set(getConfigurationFileName<ConfigurationType>(), checked) || changed;
+        return status;
+    }
+
+    /**
+     * @brief The manifest entry that describes the configuration's file, found by checking it.
+     */
+    template <typename ConfigurationType>
+    Manifest::Entry probeEntry()
+    {
+        const std::vector<ParameterInfo> &parameters = ConfigurationSchema<ConfigurationType>::getInfo().parameters;
+        if (configurationIsComplete<ConfigurationType>(std::nullopt))
+            return Manifest::makeEntry(parameters, true);
+        Manifest::Entry entry = Manifest::makeEntry(parameters, false);
+        entry.present = configurationExists<ConfigurationType>(std::nullopt);
+        return entry;
     }
 
     template <typename ConfigurationType>
-    bool configurationExists()
+    bool configurationExists(const std::optional<Manifest> &manifest)
     {
-        return storageMedium.exists(getConfigurationFileName<ConfigurationType>());
+        const Manifest::Entry *entry = findManifestEntry<ConfigurationType>(manifest);
+        if (entry != nullptr)
+            return entry->present;
+        return packedIsValid<ConfigurationType>() || storageMedium.exists(getConfigurationFileName<ConfigurationType>());
     }
 
     template <typename ConfigurationType>
-    bool configurationIsComplete()
+    bool configurationIsComplete(const std::optional<Manifest> &manifest)
     {
-        ConfigInfo info = ConfigurationFunctions<ConfigurationType>::getConfigInfo();
-        String fileName = getConfigurationFileName<ConfigurationType>();
+        const ConfigInfo &info = ConfigurationSchema<ConfigurationType>::getInfo();
+        const Manifest::Entry *entry = findManifestEntry<ConfigurationType>(manifest);
+        if (entry != nullptr)
+            return entry->present && entry->complete;
+        // A blob that matches the schema has all the fields.
+        if (packedIsValid<ConfigurationType>())
+            return true;
+        const String &fileName = getConfigurationFileName<ConfigurationType>();
         return storageMedium.isComplete(fileName, info.parameters);
     }
 
     template <typename ConfigurationType>
-    String getConfigurationFileName()
+    const String &getConfigurationFileName()
     {
-        return ConfigurationFunctions<ConfigurationType>::getConfigFileName();
+        return ConfigurationSchema<ConfigurationType>::getFileName();
     }
 
     template <typename ConfigurationType>
     void loadConfigParameters(ParametersManager &paramsManager)
     {
-        ConfigInfo info = ConfigurationFunctions<ConfigurationType>::getConfigInfo();
+        const ConfigInfo &info = ConfigurationSchema<ConfigurationType>::getInfo();
         std::map<String, String> currentValues;
-        if (configurationExists<ConfigurationType>())
+        if constexpr (IsPackable<ConfigurationType>::value)
         {
-            StorageMedium::FileHandler fileHandler = createFileHandler<ConfigurationType>(FileMode::READ);
-            // Failed to open the file even though it exists.
-            if (!fileHandler)
-            {
-                const String fileName = getConfigurationFileName<ConfigurationType>();
-                Serial.printf("Error opening file: \"%s\"\n", fileName);
-                throw std::runtime_error("Error opening file!");
-            }
-            currentValues = ConfigurationFunctions<ConfigurationType>::loadAsMap(fileHandler);
+            ConfigurationType packed{};
+            if (loadPacked(packed))
+                currentValues = ConfigurationFunctions<ConfigurationType>::toMap(packed);
+        }
+        if (currentValues.empty())
+        {
+            StorageMedium::FileHandler fileHandler = openIfExists<ConfigurationType>();
+            if (fileHandler.isFound())
+                currentValues = ConfigurationFunctions<ConfigurationType>::loadAsMap(fileHandler);
         }
 
         const auto &getOptionsFunc = ConfigurationFunctions<ConfigurationType>::getOptionsFor;
@@ -229,24 +779,126 @@ private:
         }
     }
 
+    /**
+     * @brief Opens the configuration file for reading if it exists.
+     * A file that exists but cannot be opened is an error; otherwise check `isFound()` on the result.
+     */
+    template <typename ConfigurationType>
+    StorageMedium::FileHandler openIfExists()
+    {
+        return openIfExists<ConfigurationType>(storageMedium);
+    }
+
+    /**
+     * @brief `openIfExists`, through `medium` (the storage medium, or a decorator of it).
+     */
+    template <typename ConfigurationType>
+    StorageMedium::FileHandler openIfExists(StorageMedium &medium)
+    {
+        const String &fileName = getConfigurationFileName<ConfigurationType>();
+        StorageMedium::FileHandler fileHandler = medium.openIfExists(fileName);
+        if (fileHandler.isFound() && !fileHandler)
+        {
+            // Failed to open the file even though it exists.
+            Serial.printf("Error opening file: \"%s\"\n", fileName.c_str());
+            throw std::runtime_error("Error opening file!");
+        }
+        return fileHandler;
+    }
+
     template <typename ConfigurationType>
     bool deleteConfiguration()
     {
-        return storageMedium.deleteConfig(getConfigurationFileName<ConfigurationType>());
+        const String &fileName = getConfigurationFileName<ConfigurationType>();
+        const bool blobDeleted = encoding == StorageEncoding::PACKED && storageMedium.deleteBlob(fileName);
+        return storageMedium.deleteConfig(fileName) || blobDeleted;
+    }
+
+    /**
+     * @brief Writes the configuration as one packed blob, built from all the values, and deletes the keys of an earlier save in keys.
+     *
+     * @return false if the configuration is not stored packed, or the medium does not support blobs (it must then be saved in keys).
+     */
+    template <typename ConfigurationType>
+    bool savePacked(const ParameterValuesView &values, StorageMedium &target)
+    {
+        if constexpr (IsPackable<ConfigurationType>::value)
+        {
+            if (encoding != StorageEncoding::PACKED)
+                return false;
+            const String &fileName = getConfigurationFileName<ConfigurationType>();
+            const ConfigurationType configuration = ConfigurationFunctions<ConfigurationType>::fromValues(values);
+            const auto entries = ConfigurationFunctions<ConfigurationType>::getEntries(configuration);
+            if (!target.writeBlob(fileName, PackedConfiguration::encode(entries.data(), entries.size())))
+                return false;
+            // Keys left by an earlier save in keys would otherwise be read back, with their old values, if the blob ever became corrupt.
+            target.deleteConfig(fileName);
+            return true;
+        }
+        else
+            return false;
+    }
+
+    /**
+     * @brief What a save of the configuration to `target` writes.
+     */
+    template <typename ConfigurationType>
+    SaveScope getSaveScope(ParametersManager &paramsManager, StorageMedium &target, const std::optional<Manifest> &manifest)
+    {
+        const ConfigInfo &config = ConfigurationSchema<ConfigurationType>::getInfo();
+        const size_t modifiedCount = paramsManager.countModified(config.title);
+        // The unchanged values are already in the file only if it is complete. That is only checked when it can save writes:
+        // to skip an unmodified configuration, or to write only the modified keys on a medium that can update keys in place.
+        const bool partial = modifiedCount < paramsManager.getParametersView(config.title).size() && (modifiedCount == 0 || target.supportsUpdate());
+        if (!partial || !configurationIsComplete<ConfigurationType>(manifest))
+            return SaveScope::ALL;
+        return modifiedCount == 0 ? SaveScope::NONE : SaveScope::MODIFIED;
     }
 
+    /**
+     * @brief Writes the configuration to `target`: the storage medium, or a medium that stages the writes in a journal.
+     */
     template <typename ConfigurationType>
-    void saveConfig(ParametersManager &paramsManager)
+    void saveConfig(ParametersManager &paramsManager, StorageMedium &target, const SaveScope scope)
     {
-        auto fileHandler = createFileHandler<ConfigurationType>(FileMode::WRITE);
+        if (scope == SaveScope::NONE)
+            return;
+        const ConfigInfo &config = ConfigurationSchema<ConfigurationType>::getInfo();
+        const ParameterValuesView values = paramsManager.getParametersView(config.title);
+        // A packed configuration is always written whole, in a single write.
+        if (savePacked<ConfigurationType>(values, target))
+            return;
+        const bool updateOnly = scope == SaveScope::MODIFIED;
+
+        const String &fileName = getConfigurationFileName<ConfigurationType>();
+        auto fileHandler = target.createFileHandler(fileName, updateOnly ? FileMode::UPDATE : FileMode::WRITE);
         if (!fileHandler)
         {
-            const String fileName = getConfigurationFileName<ConfigurationType>();
-            Serial.printf("Error opening file: \"%s\"\n", fileName);
+            Serial.printf("Error opening file: \"%s\"\n", fileName.c_str());
             throw std::runtime_error("Error opening file!");
         }
-        ConfigInfo config = ConfigurationFunctions<ConfigurationType>::getConfigInfo();
-        ConfigurationFunctions<ConfigurationType>::save(paramsManager.getParametersValues(config.title), fileHandler);
+        if (updateOnly)
+            // Skip the parameters that were not modified, keys that are not parameters are written as usual.
+            fileHandler.setWriteFilter([&values](const String &key)
+                                       { return values.count(key) == 0 || values.isModified(key); });
+        saveConfigurationValues<ConfigurationType>(values, fileHandler);
+    }
+
+    /**
+     * @brief Commits the staged writes with a single blob write, performs them, and then deletes the journal.
+     * A reset before the journal is written leaves everything as before the save, a reset after it is completed by `recoverJournal`.
+     */
+    void commitJournal(const Journal &journal)
+    {
+        if (journal.empty())
+            return;
+        if (!storageMedium.writeBlob(Journal::FILE_NAME, journal.encode()))
+        {
+            Serial.printf("Error writing the journal: \"%s\"\n", Journal::FILE_NAME);
+            throw std::runtime_error("Error writing the journal!");
+        }
+        journal.apply(storageMedium);
+        storageMedium.deleteBlob(Journal::FILE_NAME);
     }
 };
 
@@ -0,0 +1,132 @@
+#ifndef __H_CONFIGURATION_SNAPSHOT__
+#define __H_CONFIGURATION_SNAPSHOT__
+#include <WString.h>
+#include <stdexcept>
+#include <stdint.h>
+#include <string_view>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include "ConfigurationFields.h"
+#include "MappedRegion.h"
+#include "internal/PackedConfiguration.h"
+
+/**
+ * @brief A read-only view of a configuration stored as a packed image (see `PackedConfiguration`), typically memory-mapped with `MappedRegion`.
+ *
+ * The image is checked once (checksum and schema) when the snapshot is created, after which fields are read in place:
+ * numbers are decoded from the image and strings are returned as `std::string_view`s into it, without heap copies or storage medium accesses.
+ * Example:
+ * ```
+ * MappedRegion::storeFile("/tmp/wifi.img", ConfigurationSnapshot<WifiConfig>::pack(config));
+ * ConfigurationSnapshot<WifiConfig> snapshot(MappedRegion::mapFile("/tmp/wifi.img"));
+ * if (snapshot)
+ *     connect(snapshot.get(&WifiConfig::ssid), snapshot.get(&WifiConfig::port));
+ * ```
+ *
+ * @tparam T The type of the configuration object, declared with `ConfigurationFields`.
+ */
+template <typename T>
+class ConfigurationSnapshot
+{
+    static_assert(IsPackable<T>::value, "Snapshots require a configuration declared with ConfigurationFields");
+
+public:
+    /**
+     * @param region The image, which may be followed by other data (e.g. the rest of a flash partition).
+     */
+    explicit ConfigurationSnapshot(MappedRegion &&region)
+        : region(std::move(region)), status(PackedConfiguration::DecodeResult::CORRUPT), offsets()
+    {
+        size_t blobSize;
+        const auto entries = ConfigurationFunctions<T>::getEntries(getSchemaObject());
+        status = PackedConfiguration::index(this->region.getData(), this->region.getSize(), entries.data(), entries.size(), offsets, blobSize);
+    }
+
+    /**
+     * @brief Whether the image is valid and was written for the current fields of `T`, if not the fields cannot be read.
+     */
+    explicit operator bool() const { return status == PackedConfiguration::DecodeResult::OK; }
+
+    PackedConfiguration::DecodeResult getStatus() const { return status; }
+
+    /**
+     * @brief The value of a field, read in place; `std::string_view` for `String` fields (valid as long as the snapshot).
+     *
+     * @throws std::runtime_error If the snapshot is not valid.
+     * @throws std::invalid_argument If `member` is not one of the declared fields.
+     */
+    template <typename M>
+    std::conditional_t<std::is_same<M, String>::value, std::string_view, M> get(M T::*member) const
+    {
+        if (!*this)
+            throw std::runtime_error("Reading from an invalid configuration snapshot!");
+        std::conditional_t<std::is_same<M, String>::value, std::string_view, M> value{};
+        bool found = false;
+        size_t index = 0;
+        std::apply([&](const auto &...field)
+                   { ((found = found || readIfMember(field, member, index++, value)), ...); },
+                   ConfigurationFunctions<T>::getFieldDefinitions());
+        if (!found)
+            throw std::invalid_argument("Not a field of the configuration!");
+        return value;
+    }
+
+    /**
+     * @brief Copies all the fields into a configuration object.
+     */
+    T toObject() const
+    {
+        if (!*this)
+            throw std::runtime_error("Reading from an invalid configuration snapshot!");
+        T configuration{};
+        const auto entries = ConfigurationFunctions<T>::getEntries(configuration);
+        for (size_t i = 0; i < entries.size(); i++)
+            PackedConfiguration::readField(region.getData(), offsets[i], entries[i]);
+        return configuration;
+    }
+
+    /**
+     * @brief Packs `configuration` into an image that can be stored (e.g. with `MappedRegion::storeFile`) and mapped into a snapshot.
+     */
+    static std::vector<uint8_t> pack(const T &configuration)
+    {
+        const auto entries = ConfigurationFunctions<T>::getEntries(configuration);
+        return PackedConfiguration::encode(entries.data(), entries.size());
+    }
+
+private:
+    MappedRegion region;
+    PackedConfiguration::DecodeResult status;
+    /// @brief The offset of each field in the image.
+    std::vector<uint32_t> offsets;
+
+    /**
+     * @brief An object whose entries describe the schema (only the keys and types of the entries are used).
+     */
+    static const T &getSchemaObject()
+    {
+        static const T schema{};
+        return schema;
+    }
+
+    template <typename Field, typename M, typename V>
+    bool readIfMember(const Field &field, M T::*member, const size_t index, V &value) const
+    {
+        if constexpr (std::is_same<Field, ConfigurationField<T, M>>::value)
+        {
+            if (field.member != member)
+                return false;
+            if constexpr (std::is_same<M, String>::value)
+                value = PackedConfiguration::readString(region.getData(), offsets[index]);
+            else
+                PackedConfiguration::readField(region.getData(), offsets[index], StorageMedium::BatchEntry(field.info.name, &value));
+            return true;
+        }
+        else
+            return false;
+    }
+};
+
+#endif // __H_CONFIGURATION_SNAPSHOT__
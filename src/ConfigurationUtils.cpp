@@ -3,54 +3,45 @@
 
 ParameterInfo numericParameter(const String &name, const ParameterAttribute attribute, const int min, const int max)
 {
-  return customParameter(name, ParameterType::TYPE_INT, attribute, [name, min, max](const String &value) -> ValidationResult
-                         {
-    int result;
-    if (tryGetInt(value, &result) && result >= min && result <= max)
-      return ValidationResult::Success();
-    return ValidationResult::Failure(name + ": value (" + value + ") is out of range [" + min + ", " + max + "]"); });
+  return {name, ParameterType::TYPE_INT, attribute, Validator::IntRange(min, max)};
 }
 
 ParameterInfo floatParameter(const String &name, const ParameterAttribute attribute, const float min, const float max)
 {
-  return customParameter(name, ParameterType::TYPE_FLOAT, attribute, [name, min, max](const String &value) -> ValidationResult
-                         {
-    float result;
-    if (tryGetFloat(value, &result) && result >= min && result <= max)
-      return ValidationResult::Success();
-    return ValidationResult::Failure(name + ": value (" + value + ") is out of range [" + min + ", " + max + "]"); });
+  return {name, ParameterType::TYPE_FLOAT, attribute, Validator::FloatRange(min, max)};
 }
 
 ParameterInfo booleanParameter(const String &name, const ParameterAttribute attribute)
 {
-  return customParameter(name, ParameterType::TYPE_BOOL, attribute, [name](const String &value) -> ValidationResult
-                         {
-    if (value.equalsIgnoreCase("true") || value.equalsIgnoreCase("false"))
-      return ValidationResult::Success();
-    return ValidationResult::Failure(name + ": value must be true/false"); });
+  return {name, ParameterType::TYPE_BOOL, attribute, Validator::Boolean()};
 }
 
-ParameterInfo optionSetParameter(const String &name, const ParameterAttribute attribute, const std::function<std::vector<String>()> optionsFunc)
+ParameterInfo optionSetParameter(const String &name, const ParameterAttribute attribute, const std::function<std::vector<String>()> optionsFunc, const unsigned long refreshIntervalMs)
 {
-  return customParameter(name, ParameterType::TYPE_OPTIONSET, attribute, [name, optionsFunc](const String &value) -> ValidationResult
-                         {
-                          if (optionsFunc == nullptr) return ValidationResult::Success();
-                          const auto& options = optionsFunc();
-    if (options.empty() || std::find(options.begin(), options.end(), value) != options.end())
-      return ValidationResult::Success();
-    return ValidationResult::Failure(name + ": " + value + " is invalid, options are: [" + vectorToString(options) + "]"); });
+  if (optionsFunc == nullptr)
+    return {name, ParameterType::TYPE_OPTIONSET, attribute, Validator()};
+  return {name, ParameterType::TYPE_OPTIONSET, attribute, Validator::OneOf(optionsFunc, refreshIntervalMs)};
 }
 
 ParameterInfo stringParameter(const String &name, const ParameterAttribute attribute, const uint maxLength)
 {
-  return customParameter(name, ParameterType::TYPE_STRING, attribute, [name, maxLength](const String &value) -> ValidationResult
-                         {
-    if (value.length() <= maxLength)
-      return ValidationResult::Success();
-    return ValidationResult::Failure(name + ": value's length must be less than " + maxLength); });
+  return {name, ParameterType::TYPE_STRING, attribute, Validator::MaxLength(maxLength)};
 }
 
 ParameterInfo customParameter(const String &name, const ParameterType type, const ParameterAttribute attribute, std::function<ValidationResult(const String &value)> validationFunction)
 {
-  return {name, type, attribute, validationFunction};
+  return {name, type, attribute, Validator(std::move(validationFunction))};
+}
+
+ConfigInfo makeConfigInfo(const char *title, const ParameterDefinition *definitions, const size_t count)
+{
+  std::vector<ParameterInfo> parameters;
+  parameters.reserve(count);
+  for (size_t i = 0; i < count; i++)
+  {
+    const ParameterDefinition &definition = definitions[i];
+    // A function pointer (or nullptr, for no validation) needs no closure.
+    parameters.push_back({definition.name, definition.type, definition.specialAttribute, Validator(definition.isValid)});
+  }
+  return {title, parameters};
 }
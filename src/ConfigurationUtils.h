@@ -3,9 +3,12 @@
 #include <WString.h>
 #include <functional>
 #include <map>
+#include <type_traits>
+#include <utility>
 #include <vector>
 #include "DataStructures.h"
 #include "StorageMedium.h"
+#include "internal/ParametersManager.h"
 #include "internal/ValidationResult.h"
 
 /**
@@ -52,12 +55,16 @@ ParameterInfo booleanParameter(const String &name, const ParameterAttribute attr
 /**
  * @brief Create a parameter of type 'optionset' with the specified attribute and a validation function that ensures the value is one of the valid options.
  *
+ * The parameter only keeps `optionsFunc`, the options are cached by whoever validates the values (one `OptionSet` per `ParametersManager`, i.e. per input session),
+ * so `optionsFunc` is called once per session until the cache is refreshed, and the options are freed with the session.
+ *
  * @param name The parameter's name (must be unique in a configuration scope).
  * @param attribute The parameter's special attribute.
  * @param optionsFunc A function that returns all valid values for the parameter, may return `nullptr` in which case the validation function will always return success.
+ * @param refreshIntervalMs The time after which the options are fetched again (e.g. for a Wi-Fi scan), `0` to keep them until refreshed explicitly.
  * @return ParameterInfo
  */
-ParameterInfo optionSetParameter(const String &name, const ParameterAttribute attribute, const std::function<std::vector<String>()> optionsFunc = nullptr);
+ParameterInfo optionSetParameter(const String &name, const ParameterAttribute attribute, const std::function<std::vector<String>()> optionsFunc = nullptr, const unsigned long refreshIntervalMs = 0);
 
 /**
  * @brief Create a parameter of type 'type' with the specified attribute and the given validation function.
@@ -70,6 +77,29 @@ ParameterInfo optionSetParameter(const String &name, const ParameterAttribute at
  */
 ParameterInfo customParameter(const String &name, const ParameterType type, const ParameterAttribute attribute, std::function<ValidationResult(const String &value)> validationFunction);
 
+/**
+ * @brief Create the metadata of a configuration from a compile-time table of parameter definitions.
+ *
+ * @param title The configuration's title.
+ * @param definitions The parameters of the configuration.
+ * @param count The number of elements in `definitions`.
+ * @return ConfigInfo
+ */
+ConfigInfo makeConfigInfo(const char *title, const ParameterDefinition *definitions, const size_t count);
+
+/**
+ * @brief Create the metadata of a configuration from a compile-time table of parameter definitions.
+ *
+ * @param title The configuration's title.
+ * @param definitions The parameters of the configuration.
+ * @return ConfigInfo
+ */
+template <size_t N>
+ConfigInfo makeConfigInfo(const char *title, const ParameterDefinition (&definitions)[N])
+{
+    return makeConfigInfo(title, definitions, N);
+}
+
 /**
  * @brief Struct that provides a collection of static utility functions that every configuration must implement.
  * These functions include essential operations like loading, saving, and validating configurations, ensuring consistency and reliability across different configuration types.
@@ -82,11 +112,16 @@ struct ConfigurationFunctions
     /**
      * @brief Returns the configuration's metadata.
      *
+     * Note: The library calls this function once and keeps the result in `ConfigurationSchema<T>`.
+     * Use `makeConfigInfo` to build it from a `constexpr` table of `ParameterDefinition`.
+     *
      */
     static ConfigInfo getConfigInfo();
 
     /**
      * @brief Get the name of the file in which the configuration is stored.
+     *
+     * Note: The library calls this function once and keeps the result in `ConfigurationSchema<T>`.
      */
     static String getConfigFileName();
 
@@ -110,6 +145,19 @@ struct ConfigurationFunctions
      */
     static void save(const std::map<String, String> &values, StorageMedium::FileHandler &fileHandler);
 
+    /**
+     * @brief Writes the values in the given view into the storage medium.
+     *
+     * Optional: implement it to save without copying the values into a map, otherwise the values are copied and passed to the map overload.
+     *
+     * @param values A view of the parameters' values, by name.
+     * @param fileHandler The file handler for the configuration file.
+     */
+    static void save(const ParameterValuesView &values, StorageMedium::FileHandler &fileHandler)
+    {
+        save(values.toMap(), fileHandler);
+    }
+
     /**
      * @brief Loads the configuration from the storage medium as a map whose values are the parameters' names and the values are the parameters' values.
      *
@@ -133,6 +181,112 @@ struct ConfigurationFunctions
      * @return ValidationResult - That represents either a success or a failure, and holds the error message (incase of a failure).
      */
     static const ValidationResult validate(const std::map<String, String> &values);
+
+    /**
+     * @brief Validates that the given parameters' values are valid for configuration of type `T`.
+     *
+     * Optional: implement it to validate without copying the values into a map, otherwise the values are copied and passed to the map overload.
+     *
+     * @param values A view of the parameters' values, by name.
+     * @return ValidationResult - That represents either a success or a failure, and holds the error message (incase of a failure).
+     */
+    static const ValidationResult validate(const ParameterValuesView &values)
+    {
+        return validate(values.toMap());
+    }
+};
+
+#pragma region Detection of optional ConfigurationFunctions members
+template <typename T, typename = void>
+struct HasViewValidate : std::false_type
+{
+};
+template <typename T>
+struct HasViewValidate<T, std::void_t<decltype(ConfigurationFunctions<T>::validate(std::declval<const ParameterValuesView &>()))>> : std::true_type
+{
+};
+
+template <typename T, typename = void>
+struct HasViewSave : std::false_type
+{
+};
+template <typename T>
+struct HasViewSave<T, std::void_t<decltype(ConfigurationFunctions<T>::save(std::declval<const ParameterValuesView &>(), std::declval<StorageMedium::FileHandler &>()))>> : std::true_type
+{
+};
+
+/**
+ * A configuration can be stored as one packed blob (see `StorageEncoding::PACKED`) if `ConfigurationFunctions<T>` also has:
+ * - `static auto getEntries(T &configuration)` and `static auto getEntries(const T &configuration)` - A container of `StorageMedium::BatchEntry` for all the fields.
+ * - `static T fromValues(const ParameterValuesView &values)` - Builds an object from the parameters' values.
+ * - `static std::map<String, String> toMap(const T &configuration)` - The parameters' values of an object, as `loadAsMap` returns them.
+ * Configurations declared with `ConfigurationFields` have them.
+ */
+template <typename T, typename = void>
+struct IsPackable : std::false_type
+{
+};
+template <typename T>
+struct IsPackable<T, std::void_t<decltype(ConfigurationFunctions<T>::getEntries(std::declval<T &>()).data()),
+                                 decltype(ConfigurationFunctions<T>::getEntries(std::declval<const T &>()).data()),
+                                 decltype(ConfigurationFunctions<T>::fromValues(std::declval<const ParameterValuesView &>())),
+                                 decltype(ConfigurationFunctions<T>::toMap(std::declval<const T &>()))>> : std::true_type
+{
+};
+#pragma endregion
+
+/**
+ * @brief Validates the values in `values` with `ConfigurationFunctions<T>::validate`, using the view overload when the configuration provides one.
+ */
+template <typename T>
+const ValidationResult validateConfigurationValues(const ParameterValuesView &values)
+{
+    if constexpr (HasViewValidate<T>::value)
+        return ConfigurationFunctions<T>::validate(values);
+    else
+        return ConfigurationFunctions<T>::validate(values.toMap());
+}
+
+/**
+ * @brief Saves the values in `values` with `ConfigurationFunctions<T>::save`, using the view overload when the configuration provides one.
+ */
+template <typename T>
+void saveConfigurationValues(const ParameterValuesView &values, StorageMedium::FileHandler &fileHandler)
+{
+    if constexpr (HasViewSave<T>::value)
+        ConfigurationFunctions<T>::save(values, fileHandler);
+    else
+        ConfigurationFunctions<T>::save(values.toMap(), fileHandler);
+}
+
+/**
+ * @brief Holds the metadata of configuration type `T`, built once from `ConfigurationFunctions<T>` and then shared by reference.
+ *
+ * The library reads the metadata through this struct instead of calling `ConfigurationFunctions<T>::getConfigInfo()` each time,
+ * so it is allocated once per type for the lifetime of the program rather than on every operation.
+ *
+ * @tparam T The type of the configuration object.
+ */
+template <typename T>
+struct ConfigurationSchema
+{
+    /**
+     * @brief The configuration's metadata.
+     */
+    static const ConfigInfo &getInfo()
+    {
+        static const ConfigInfo info = ConfigurationFunctions<T>::getConfigInfo();
+        return info;
+    }
+
+    /**
+     * @brief The name of the file in which the configuration is stored.
+     */
+    static const String &getFileName()
+    {
+        static const String fileName = ConfigurationFunctions<T>::getConfigFileName();
+        return fileName;
+    }
 };
 
 #endif  // __H_CONFIGURATION_UTILS__
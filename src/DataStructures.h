@@ -6,6 +6,7 @@
 #include <functional>
 #include <vector>
 #include "internal/ValidationResult.h"
+#include "internal/Validator.h"
 
 enum class ParameterType : uint8_t
 {
@@ -32,9 +33,28 @@ typedef struct
   String name;
   ParameterType type;
   ParameterAttribute specialAttribute;
-  std::function<const ValidationResult(const String &)> isValid;
+  /// @brief The validation function, call it as `isValid(name, value)` (or `isValid(value)`, whose error messages do not name the parameter).
+  Validator isValid;
 } ParameterInfo;
 
+// The validation of a parameter is its kind and two 64-bit bounds (see `Validator`), not the `std::function` (or two) it used to be.
+static_assert(sizeof(ParameterInfo) <= sizeof(String) + 4 * sizeof(int64_t), "A parameter must hold its validation in the validator's data");
+
+/**
+ * @brief Compile-time form of `ParameterInfo`: plain data (string literal, function pointer) that can be declared `constexpr`
+ * and kept in flash, e.g. `static constexpr ParameterDefinition parameters[] = {{"ssid", ParameterType::TYPE_STRING, ParameterAttribute::ATTR_NONE, validateSsid}};`.
+ * Convert a table of definitions with `makeConfigInfo`.
+ *
+ */
+struct ParameterDefinition
+{
+  const char *name;
+  ParameterType type;
+  ParameterAttribute specialAttribute;
+  /// @brief The validation function, or `nullptr` if every value is valid.
+  const ValidationResult (*isValid)(const String &value);
+};
+
 /**
  * @brief Contains the metada of a configuration.
  *
@@ -18,16 +18,31 @@ public:
      * @brief Sets the validation and save functions, and the parameters manager for following sessions.
      * 
      * @param parametersManager The `ParametersManager` instance to use for the next input sessions.
-     * @param validateCallback Callback function to validate the current state of `parametersManager` instance.
+     * @param validateCallback Callback function to validate the current state of `parametersManager` instance, keeping at most the given number of errors.
      * @param saveCallback Callback function to save the state the current state of `parametersManager` instance.
      */
-    void initialize(ParametersManager *parametersManager, const std::function<ChainedValidationResults()> validateCallback, const std::function<void()> saveCallback)
+    void initialize(ParametersManager *parametersManager, const std::function<ChainedValidationResults(size_t maxErrors)> validateCallback, const std::function<void()> saveCallback)
     {
         this->parameters = parametersManager;
         this->validate = validateCallback;
         this->save = saveCallback;
     }
 
+    /**
+     * @brief Sets the validation and save functions, and the parameters manager for following sessions.
+     * The validation callback always validates every value, it does not know how many errors are needed.
+     *
+     * @param parametersManager The `ParametersManager` instance to use for the next input sessions.
+     * @param validateCallback Callback function to validate the current state of `parametersManager` instance.
+     * @param saveCallback Callback function to save the state the current state of `parametersManager` instance.
+     */
+    void initialize(ParametersManager *parametersManager, const std::function<ChainedValidationResults()> validateCallback, const std::function<void()> saveCallback)
+    {
+        initialize(parametersManager, [validateCallback](const size_t _)
+                   { return validateCallback(); },
+                   saveCallback);
+    }
+
     /**
      * @brief Add the configuration's parameters to this input interface.
      * 
@@ -35,7 +50,7 @@ public:
      */
     void registerConfiguration(const ConfigInfo &info)
     {
-        init(info, parameters->getParametersValues(info.title));
+        init(info, parameters->getParametersView(info.title));
     }
 
     /**
@@ -65,9 +80,14 @@ protected:
 
     void cancelSession() { currentState = SessionState::ABORTED; }
 
-    ChainedValidationResults validateInput()
+    /**
+     * @brief Validates the input, the session ends (and the values are saved) if it is valid.
+     *
+     * @param maxErrors Stop validating after that many errors, e.g. `ChainedValidationResults::FAIL_FAST` if the errors are not displayed.
+     */
+    ChainedValidationResults validateInput(const size_t maxErrors = ChainedValidationResults::UNBOUNDED)
     {
-        auto validationResult = validate();
+        auto validationResult = validate(maxErrors);
         currentState = validationResult.match<SessionState>([]()
                                                             { return SessionState::INPUT_VALIDATED; },
                                                             [](const std::vector<String> &_)
@@ -77,6 +97,15 @@ protected:
 
     virtual void init(const ConfigInfo &configInfo, const std::map<String, String> &currentValues) = 0;
 
+    /**
+     * @brief Called for each registered configuration with a view of its current values.
+     * Override it to read the values without copying them, by default they are copied into a map and passed to the map overload.
+     */
+    virtual void init(const ConfigInfo &configInfo, const ParameterValuesView &currentValues)
+    {
+        init(configInfo, currentValues.toMap());
+    }
+
     virtual void startImpl() = 0;
     virtual void update() = 0;
     virtual void cleanup() = 0;
@@ -92,7 +121,7 @@ private:
         ABORTED
     };
     ParametersManager *parameters;
-    std::function<ChainedValidationResults()> validate;
+    std::function<ChainedValidationResults(size_t maxErrors)> validate;
     std::function<void()> save;
     SessionState currentState;
 };
@@ -0,0 +1,212 @@
+#include "InstrumentedStorageMedium.h"
+
+namespace
+{
+    size_t getHistogramBucket(uint32_t micros)
+    {
+        size_t bucket = 0;
+        while (micros != 0 && bucket < InstrumentedStorageMedium::HISTOGRAM_BUCKETS - 1)
+        {
+            micros >>= 1;
+            bucket++;
+        }
+        return bucket;
+    }
+
+    uint64_t getBatchSize(const StorageMedium::BatchEntry *entries, const size_t count)
+    {
+        uint64_t bytes = 0;
+        for (size_t i = 0; i < count; i++)
+            bytes += entries[i].getValueSize();
+        return bytes;
+    }
+
+    void dumpStatistics(Print &output, const InstrumentedStorageMedium::Statistics &statistics)
+    {
+        for (size_t i = 0; i < InstrumentedStorageMedium::OPERATIONS_COUNT; i++)
+        {
+            const InstrumentedStorageMedium::OperationStatistics &operation = statistics.operations[i];
+            if (operation.count == 0)
+                continue;
+            output.printf("  %-12s count=%lu bytes=%llu total=%lluus avg=%lluus max=%luus |",
+                          InstrumentedStorageMedium::getOperationName(static_cast<InstrumentedStorageMedium::Operation>(i)),
+                          static_cast<unsigned long>(operation.count), static_cast<unsigned long long>(operation.bytes),
+                          static_cast<unsigned long long>(operation.totalMicros), static_cast<unsigned long long>(operation.totalMicros / operation.count),
+                          static_cast<unsigned long>(operation.maxMicros));
+            for (size_t bucket = 0; bucket < InstrumentedStorageMedium::HISTOGRAM_BUCKETS; bucket++)
+            {
+                if (operation.histogram[bucket] == 0)
+                    continue;
+                if (bucket == InstrumentedStorageMedium::HISTOGRAM_BUCKETS - 1)
+                    output.printf(" >=%luus:%lu", 1UL << (bucket - 1), static_cast<unsigned long>(operation.histogram[bucket]));
+                else
+                    output.printf(" <%luus:%lu", 1UL << bucket, static_cast<unsigned long>(operation.histogram[bucket]));
+            }
+            output.println();
+        }
+    }
+}
+
+InstrumentedStorageMedium::InstrumentedStorageMedium(StorageMedium &inner)
+    : StorageMediumDecorator(inner), totals(), files(), currentFileName(), currentFile(&files[currentFileName]) {}
+
+void InstrumentedStorageMedium::reset()
+{
+    totals = Statistics();
+    files.clear();
+    currentFile = &files[currentFileName];
+}
+
+void InstrumentedStorageMedium::dump(Print &output) const
+{
+    output.println("Storage medium totals:");
+    dumpStatistics(output, totals);
+    for (const auto &[fileName, statistics] : files)
+    {
+        // Skip the placeholder entry for "no file is open" when nothing was done outside a file.
+        if (fileName.isEmpty() && statistics[Operation::READ].count == 0 && statistics[Operation::WRITE].count == 0)
+            continue;
+        output.printf("File \"%s\":\n", fileName.c_str());
+        dumpStatistics(output, statistics);
+    }
+}
+
+const char *InstrumentedStorageMedium::getOperationName(const Operation operation)
+{
+    switch (operation)
+    {
+    case Operation::OPEN:
+        return "open";
+    case Operation::CLOSE:
+        return "close";
+    case Operation::EXISTS:
+        return "exists";
+    case Operation::IS_COMPLETE:
+        return "isComplete";
+    case Operation::DELETE:
+        return "delete";
+    case Operation::READ:
+        return "read";
+    case Operation::WRITE:
+        return "write";
+    case Operation::READ_BATCH:
+        return "readBatch";
+    case Operation::WRITE_BATCH:
+        return "writeBatch";
+    case Operation::READ_BLOB:
+        return "readBlob";
+    case Operation::WRITE_BLOB:
+        return "writeBlob";
+    }
+    return "unknown";
+}
+
+bool InstrumentedStorageMedium::openFile(const String &fileName, const FileMode fileMode)
+{
+    currentFileName = fileName;
+    currentFile = &files[fileName];
+    return measure<bool>(*currentFile, Operation::OPEN, 0, [&]()
+                         { return StorageMediumDecorator::openFile(fileName, fileMode); });
+}
+
+OpenResult InstrumentedStorageMedium::openFileIfExists(const String &fileName)
+{
+    currentFileName = fileName;
+    currentFile = &files[fileName];
+    const unsigned long start = micros();
+    const OpenResult result = StorageMediumDecorator::openFileIfExists(fileName);
+    // A missing file is found without opening anything, like `exists`.
+    record(*currentFile, result == OpenResult::NOT_FOUND ? Operation::EXISTS : Operation::OPEN, 0, micros() - start);
+    if (result != OpenResult::OPENED)
+    {
+        currentFileName = "";
+        currentFile = &files[currentFileName];
+    }
+    return result;
+}
+
+void InstrumentedStorageMedium::closeFile()
+{
+    const unsigned long start = micros();
+    StorageMediumDecorator::closeFile();
+    record(*currentFile, Operation::CLOSE, 0, micros() - start);
+    currentFileName = "";
+    currentFile = &files[currentFileName];
+}
+
+bool InstrumentedStorageMedium::existsImpl(const String &fileName)
+{
+    return measure<bool>(files[fileName], Operation::EXISTS, 0, [&]()
+                         { return StorageMediumDecorator::existsImpl(fileName); });
+}
+
+bool InstrumentedStorageMedium::isCompleteImpl(const String &fileName, const std::vector<ParameterInfo> &parameters)
+{
+    return measure<bool>(files[fileName], Operation::IS_COMPLETE, 0, [&]()
+                         { return StorageMediumDecorator::isCompleteImpl(fileName, parameters); });
+}
+
+bool InstrumentedStorageMedium::deleteImpl(const String &fileName)
+{
+    return measure<bool>(files[fileName], Operation::DELETE, 0, [&]()
+                         { return StorageMediumDecorator::deleteImpl(fileName); });
+}
+
+bool InstrumentedStorageMedium::readBlobImpl(const String &fileName, std::vector<uint8_t> &data)
+{
+    const unsigned long start = micros();
+    const bool result = StorageMediumDecorator::readBlobImpl(fileName, data);
+    const uint32_t elapsed = micros() - start;
+    record(files[fileName], Operation::READ_BLOB, result ? data.size() : 0, elapsed);
+    return result;
+}
+
+bool InstrumentedStorageMedium::writeBlobImpl(const String &fileName, const std::vector<uint8_t> &data)
+{
+    return measure<bool>(files[fileName], Operation::WRITE_BLOB, data.size(), [&]()
+                         { return StorageMediumDecorator::writeBlobImpl(fileName, data); });
+}
+
+bool InstrumentedStorageMedium::deleteBlobImpl(const String &fileName)
+{
+    return measure<bool>(files[fileName], Operation::DELETE, 0, [&]()
+                         { return StorageMediumDecorator::deleteBlobImpl(fileName); });
+}
+
+String InstrumentedStorageMedium::readString(const String &key, const String defaultValue)
+{
+    const unsigned long start = micros();
+    String result = StorageMediumDecorator::readString(key, defaultValue);
+    record(*currentFile, Operation::READ, result.length(), micros() - start);
+    return result;
+}
+
+void InstrumentedStorageMedium::readBatch(const BatchEntry *entries, const size_t count)
+{
+    const unsigned long start = micros();
+    StorageMediumDecorator::readBatch(entries, count);
+    const uint32_t elapsed = micros() - start;
+    record(*currentFile, Operation::READ_BATCH, getBatchSize(entries, count), elapsed);
+}
+
+void InstrumentedStorageMedium::writeBatch(const BatchEntry *entries, const size_t count)
+{
+    const uint64_t bytes = getBatchSize(entries, count);
+    const unsigned long start = micros();
+    StorageMediumDecorator::writeBatch(entries, count);
+    record(*currentFile, Operation::WRITE_BATCH, bytes, micros() - start);
+}
+
+void InstrumentedStorageMedium::record(Statistics &file, const Operation operation, const uint64_t bytes, const uint32_t micros)
+{
+    const size_t bucket = getHistogramBucket(micros);
+    for (OperationStatistics *statistics : {&totals[operation], &file[operation]})
+    {
+        statistics->count++;
+        statistics->bytes += bytes;
+        statistics->totalMicros += micros;
+        if (micros > statistics->maxMicros)
+            statistics->maxMicros = micros;
+        statistics->histogram[bucket]++;
+    }
+}
@@ -0,0 +1,166 @@
+#ifndef __H_INSTRUMENTED_STORAGE_MEDIUM__
+#define __H_INSTRUMENTED_STORAGE_MEDIUM__
+#include <Arduino.h>
+#include <WString.h>
+#include <map>
+#include <stdint.h>
+#include "StorageMediumDecorator.h"
+
+/**
+ * @brief A storage medium that forwards every operation to another medium and records how many times it was performed,
+ * how many bytes it moved and how long it took.
+ *
+ * Statistics are kept both for the whole medium and per file, and can be printed with `dump` (e.g. to `Serial`) or cleared with `reset`.
+ * Example: wrap the medium passed to `ConfigurationHandler` to see the cost of `loadConfigurations` at boot.
+ *
+ */
+class InstrumentedStorageMedium : public StorageMediumDecorator
+{
+public:
+    enum class Operation : uint8_t
+    {
+        OPEN,
+        CLOSE,
+        EXISTS,
+        IS_COMPLETE,
+        DELETE,
+        READ,
+        WRITE,
+        READ_BATCH,
+        WRITE_BATCH,
+        READ_BLOB,
+        WRITE_BLOB,
+    };
+    static constexpr size_t OPERATIONS_COUNT = 11;
+
+    /**
+     * @brief Latencies are grouped in powers of two: bucket 0 counts operations faster than 1us,
+     * bucket `i` counts operations that took [2^(i-1), 2^i) microseconds, and the last bucket also counts everything slower.
+     */
+    static constexpr size_t HISTOGRAM_BUCKETS = 16;
+
+    struct OperationStatistics
+    {
+        uint32_t count;
+        /// @brief Value bytes read or written (the keys are not counted).
+        uint64_t bytes;
+        uint64_t totalMicros;
+        uint32_t maxMicros;
+        uint32_t histogram[HISTOGRAM_BUCKETS];
+    };
+
+    struct Statistics
+    {
+        OperationStatistics operations[OPERATIONS_COUNT];
+
+        const OperationStatistics &operator[](const Operation operation) const { return operations[static_cast<size_t>(operation)]; }
+        OperationStatistics &operator[](const Operation operation) { return operations[static_cast<size_t>(operation)]; }
+    };
+
+    InstrumentedStorageMedium(StorageMedium &inner);
+
+    /**
+     * @brief The statistics of all the operations performed on the medium.
+     */
+    const Statistics &getTotals() const { return totals; }
+
+    /**
+     * @brief The statistics of the operations performed on each file, by file name.
+     * Reads and writes performed while no file is open are attributed to an empty file name.
+     */
+    const std::map<String, Statistics> &getFileStatistics() const { return files; }
+
+    /**
+     * @brief Clears all the collected statistics.
+     */
+    void reset();
+
+    /**
+     * @brief Prints the collected statistics in a human readable form.
+     *
+     * @param output Where to print the statistics, e.g. `Serial`.
+     */
+    void dump(Print &output) const;
+
+    static const char *getOperationName(const Operation operation);
+
+protected:
+    bool openFile(const String &fileName, const FileMode fileMode) override;
+    void closeFile() override;
+    OpenResult openFileIfExists(const String &fileName) override;
+
+    bool existsImpl(const String &fileName) override;
+    bool isCompleteImpl(const String &fileName, const std::vector<ParameterInfo> &parameters) override;
+    bool deleteImpl(const String &fileName) override;
+
+    bool readBlobImpl(const String &fileName, std::vector<uint8_t> &data) override;
+    bool writeBlobImpl(const String &fileName, const std::vector<uint8_t> &data) override;
+    bool deleteBlobImpl(const String &fileName) override;
+
+#pragma region Read and Write functions
+    int8_t readChar(const String &key, const int8_t defaultValue) override { return measureRead([&]() { return StorageMediumDecorator::readChar(key, defaultValue); }); }
+    uint8_t readUChar(const String &key, const uint8_t defaultValue) override { return measureRead([&]() { return StorageMediumDecorator::readUChar(key, defaultValue); }); }
+    int16_t readShort(const String &key, const int16_t defaultValue) override { return measureRead([&]() { return StorageMediumDecorator::readShort(key, defaultValue); }); }
+    uint16_t readUShort(const String &key, const uint16_t defaultValue) override { return measureRead([&]() { return StorageMediumDecorator::readUShort(key, defaultValue); }); }
+    int32_t readInt(const String &key, const int32_t defaultValue) override { return measureRead([&]() { return StorageMediumDecorator::readInt(key, defaultValue); }); }
+    uint32_t readUInt(const String &key, const uint32_t defaultValue) override { return measureRead([&]() { return StorageMediumDecorator::readUInt(key, defaultValue); }); }
+    int64_t readLong(const String &key, const int64_t defaultValue) override { return measureRead([&]() { return StorageMediumDecorator::readLong(key, defaultValue); }); }
+    uint64_t readULong(const String &key, const uint64_t defaultValue) override { return measureRead([&]() { return StorageMediumDecorator::readULong(key, defaultValue); }); }
+    float readFloat(const String &key, const float defaultValue) override { return measureRead([&]() { return StorageMediumDecorator::readFloat(key, defaultValue); }); }
+    double readDouble(const String &key, const double defaultValue) override { return measureRead([&]() { return StorageMediumDecorator::readDouble(key, defaultValue); }); }
+    bool readBool(const String &key, const bool defaultValue) override { return measureRead([&]() { return StorageMediumDecorator::readBool(key, defaultValue); }); }
+    String readString(const String &key, const String defaultValue) override;
+
+    void writeChar(const String &key, const int8_t value) override { measureWrite(sizeof(value), [&]() { StorageMediumDecorator::writeChar(key, value); }); }
+    void writeUChar(const String &key, const uint8_t value) override { measureWrite(sizeof(value), [&]() { StorageMediumDecorator::writeUChar(key, value); }); }
+    void writeShort(const String &key, const int16_t value) override { measureWrite(sizeof(value), [&]() { StorageMediumDecorator::writeShort(key, value); }); }
+    void writeUShort(const String &key, const uint16_t value) override { measureWrite(sizeof(value), [&]() { StorageMediumDecorator::writeUShort(key, value); }); }
+    void writeInt(const String &key, const int32_t value) override { measureWrite(sizeof(value), [&]() { StorageMediumDecorator::writeInt(key, value); }); }
+    void writeUInt(const String &key, const uint32_t value) override { measureWrite(sizeof(value), [&]() { StorageMediumDecorator::writeUInt(key, value); }); }
+    void writeLong(const String &key, const int64_t value) override { measureWrite(sizeof(value), [&]() { StorageMediumDecorator::writeLong(key, value); }); }
+    void writeULong(const String &key, const uint64_t value) override { measureWrite(sizeof(value), [&]() { StorageMediumDecorator::writeULong(key, value); }); }
+    void writeFloat(const String &key, const float value) override { measureWrite(sizeof(value), [&]() { StorageMediumDecorator::writeFloat(key, value); }); }
+    void writeDouble(const String &key, const double value) override { measureWrite(sizeof(value), [&]() { StorageMediumDecorator::writeDouble(key, value); }); }
+    void writeBool(const String &key, const bool value) override { measureWrite(sizeof(value), [&]() { StorageMediumDecorator::writeBool(key, value); }); }
+    void writeString(const String &key, const String value) override { measureWrite(value.length(), [&]() { StorageMediumDecorator::writeString(key, value); }); }
+#pragma endregion
+
+    void readBatch(const BatchEntry *entries, const size_t count) override;
+    void writeBatch(const BatchEntry *entries, const size_t count) override;
+
+private:
+    Statistics totals;
+    std::map<String, Statistics> files;
+    /// @brief The name of the currently open file, reads and writes are attributed to it.
+    String currentFileName;
+    /// @brief The statistics of the currently open file (points into `files`).
+    Statistics *currentFile;
+
+    void record(Statistics &file, const Operation operation, const uint64_t bytes, const uint32_t micros);
+
+    template <typename T, typename Func>
+    T measure(Statistics &file, const Operation operation, const uint64_t bytes, Func &&func)
+    {
+        const unsigned long start = micros();
+        T result = func();
+        record(file, operation, bytes, micros() - start);
+        return result;
+    }
+
+    template <typename Func>
+    auto measureRead(Func &&func) -> decltype(func())
+    {
+        typedef decltype(func()) T;
+        return measure<T>(*currentFile, Operation::READ, sizeof(T), func);
+    }
+
+    template <typename Func>
+    void measureWrite(const uint64_t bytes, Func &&func)
+    {
+        const unsigned long start = micros();
+        func();
+        record(*currentFile, Operation::WRITE, bytes, micros() - start);
+    }
+};
+
+#endif // __H_INSTRUMENTED_STORAGE_MEDIUM__
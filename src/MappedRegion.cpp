@@ -0,0 +1,130 @@
+#include "MappedRegion.h"
+
+#if defined(CONFIG_HANDLER_MAP_FILES)
+#include <fcntl.h>
+#include <stdio.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <WString.h>
+#elif defined(CONFIG_HANDLER_MAP_PARTITIONS)
+#include <esp_idf_version.h>
+#include <esp_partition.h>
+#if ESP_IDF_VERSION_MAJOR >= 5
+#include <spi_flash_mmap.h>
+#else
+#include <esp_spi_flash.h>
+#endif
+#endif
+
+MappedRegion::MappedRegion(MappedRegion &&other)
+    : data(other.data), size(other.size), release(std::move(other.release))
+{
+    other.data = nullptr;
+    other.size = 0;
+    other.release = nullptr;
+}
+
+MappedRegion &MappedRegion::operator=(MappedRegion &&other)
+{
+    if (this == &other)
+        return *this;
+    if (release)
+        release();
+    data = other.data;
+    size = other.size;
+    release = std::move(other.release);
+    other.data = nullptr;
+    other.size = 0;
+    other.release = nullptr;
+    return *this;
+}
+
+MappedRegion::~MappedRegion()
+{
+    if (release)
+        release();
+}
+
+#ifdef CONFIG_HANDLER_MAP_FILES
+MappedRegion MappedRegion::mapFile(const char *path)
+{
+    const int fd = open(path, O_RDONLY);
+    if (fd < 0)
+        return MappedRegion();
+    struct stat status;
+    if (fstat(fd, &status) != 0 || status.st_size <= 0)
+    {
+        close(fd);
+        return MappedRegion();
+    }
+    const size_t length = static_cast<size_t>(status.st_size);
+    void *address = mmap(nullptr, length, PROT_READ, MAP_PRIVATE, fd, 0);
+    // The mapping stays valid after the file is closed.
+    close(fd);
+    if (address == MAP_FAILED)
+        return MappedRegion();
+    return MappedRegion(static_cast<const uint8_t *>(address), length, [address, length]()
+                        { munmap(address, length); });
+}
+
+bool MappedRegion::storeFile(const char *path, const std::vector<uint8_t> &data)
+{
+    const String temporaryPath = String(path) + ".tmp";
+    const int fd = open(temporaryPath.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if (fd < 0)
+        return false;
+    size_t written = 0;
+    while (written < data.size())
+    {
+        const ssize_t result = write(fd, data.data() + written, data.size() - written);
+        if (result <= 0)
+            break;
+        written += static_cast<size_t>(result);
+    }
+    const bool success = written == data.size() && fsync(fd) == 0;
+    close(fd);
+    if (!success || rename(temporaryPath.c_str(), path) != 0)
+    {
+        unlink(temporaryPath.c_str());
+        return false;
+    }
+    return true;
+}
+#endif
+
+#ifdef CONFIG_HANDLER_MAP_PARTITIONS
+MappedRegion MappedRegion::mapPartition(const char *label)
+{
+    const esp_partition_t *partition = esp_partition_find_first(ESP_PARTITION_TYPE_DATA, ESP_PARTITION_SUBTYPE_ANY, label);
+    if (!partition)
+        return MappedRegion();
+    const void *address;
+#if ESP_IDF_VERSION_MAJOR >= 5
+    esp_partition_mmap_handle_t handle;
+#else
+    spi_flash_mmap_handle_t handle;
+#endif
+    if (esp_partition_mmap(partition, 0, partition->size, ESP_PARTITION_MMAP_DATA, &address, &handle) != ESP_OK)
+        return MappedRegion();
+    return MappedRegion(static_cast<const uint8_t *>(address), partition->size, [handle]()
+                        {
+#if ESP_IDF_VERSION_MAJOR >= 5
+                            esp_partition_munmap(handle);
+#else
+                            spi_flash_munmap(handle);
+#endif
+                        });
+}
+
+bool MappedRegion::storePartition(const char *label, const std::vector<uint8_t> &data)
+{
+    const esp_partition_t *partition = esp_partition_find_first(ESP_PARTITION_TYPE_DATA, ESP_PARTITION_SUBTYPE_ANY, label);
+    if (!partition || data.size() > partition->size)
+        return false;
+    // Erase whole sectors, the rest of the partition is left erased.
+    const size_t eraseSize = (data.size() + SPI_FLASH_SEC_SIZE - 1) / SPI_FLASH_SEC_SIZE * SPI_FLASH_SEC_SIZE;
+    return esp_partition_erase_range(partition, 0, eraseSize) == ESP_OK &&
+           esp_partition_write(partition, 0, data.data(), data.size()) == ESP_OK;
+}
+#endif
@@ -0,0 +1,89 @@
+#ifndef __H_MAPPED_REGION__
+#define __H_MAPPED_REGION__
+#include <functional>
+#include <stddef.h>
+#include <stdint.h>
+#include <vector>
+
+#if defined(ESP32)
+/// @brief `MappedRegion::mapPartition` and `MappedRegion::storePartition` are available (flash data partitions).
+#define CONFIG_HANDLER_MAP_PARTITIONS 1
+#elif !defined(ARDUINO) && (defined(__unix__) || defined(__APPLE__))
+/// @brief `MappedRegion::mapFile` and `MappedRegion::storeFile` are available (POSIX `mmap`).
+#define CONFIG_HANDLER_MAP_FILES 1
+#endif
+
+/**
+ * @brief A read-only region of memory, that is either mapped from storage (a file on the host, a flash partition on the device) and unmapped when destroyed,
+ * or borrowed from memory owned elsewhere.
+ *
+ * Mapped regions are read in place, without copying them to the heap; on the device, reads go through the flash cache.
+ *
+ */
+class MappedRegion
+{
+public:
+    /**
+     * @brief An empty region.
+     */
+    MappedRegion() : data(nullptr), size(0), release(nullptr) {}
+
+    /**
+     * @brief A region over memory owned elsewhere, which must outlive it.
+     */
+    MappedRegion(const uint8_t *data, const size_t size) : data(data), size(size), release(nullptr) {}
+
+    MappedRegion(const MappedRegion &) = delete;
+    MappedRegion &operator=(const MappedRegion &) = delete;
+    MappedRegion(MappedRegion &&other);
+    MappedRegion &operator=(MappedRegion &&other);
+    ~MappedRegion();
+
+    const uint8_t *getData() const { return data; }
+    size_t getSize() const { return size; }
+
+    /**
+     * @brief Whether the region is not empty (e.g. the mapping succeeded).
+     */
+    explicit operator bool() const { return data != nullptr && size != 0; }
+
+#ifdef CONFIG_HANDLER_MAP_FILES
+    /**
+     * @brief Maps the whole file at `path`, or returns an empty region if it does not exist or cannot be mapped.
+     */
+    static MappedRegion mapFile(const char *path);
+
+    /**
+     * @brief Replaces the content of the file at `path` with `data`, atomically (through a temporary file),
+     * so a region mapped from the previous file keeps its content.
+     *
+     * @return Whether the file was written.
+     */
+    static bool storeFile(const char *path, const std::vector<uint8_t> &data);
+#endif
+
+#ifdef CONFIG_HANDLER_MAP_PARTITIONS
+    /**
+     * @brief Maps the whole data partition with the given label, or returns an empty region if it does not exist or cannot be mapped.
+     */
+    static MappedRegion mapPartition(const char *label);
+
+    /**
+     * @brief Erases the data partition with the given label and writes `data` at its start.
+     * Regions mapped from the partition before the write may still show the previous content, map it again after storing.
+     *
+     * @return Whether the data was written.
+     */
+    static bool storePartition(const char *label, const std::vector<uint8_t> &data);
+#endif
+
+private:
+    MappedRegion(const uint8_t *data, const size_t size, const std::function<void()> &release) : data(data), size(size), release(release) {}
+
+    const uint8_t *data;
+    size_t size;
+    /// @brief Unmaps the region, `nullptr` for borrowed memory.
+    std::function<void()> release;
+};
+
+#endif // __H_MAPPED_REGION__
@@ -0,0 +1,203 @@
+#include <Arduino.h>
+#include <string.h>
+#include "MemoryStorageMedium.h"
+
+MemoryStorageMedium::MemoryStorageMedium(const LatencyModel &latency, const WearModel &wear)
+    : latency(latency), wear(wear), files(), currentFile(nullptr), statistics(),
+      eraseCounts(wear.eraseBlockCount, 0), writePosition(0)
+{
+    if (wear.eraseBlockSize == 0 || wear.eraseBlockCount == 0)
+        throw std::invalid_argument("The simulated flash region must have at least one non-empty erase block!");
+}
+
+uint32_t MemoryStorageMedium::getMaxEraseCount() const
+{
+    uint32_t max = 0;
+    for (const uint32_t count : eraseCounts)
+    {
+        if (count > max)
+            max = count;
+    }
+    return max;
+}
+
+void MemoryStorageMedium::resetStatistics()
+{
+    statistics = Statistics();
+    eraseCounts.assign(wear.eraseBlockCount, 0);
+}
+
+void MemoryStorageMedium::clear()
+{
+    files.clear();
+    blobs.clear();
+    currentFile = nullptr;
+}
+
+bool MemoryStorageMedium::openFile(const String &fileName, const FileMode fileMode)
+{
+    statistics.opens++;
+    spend(latency.openMicros);
+
+    if (fileMode == FileMode::READ)
+    {
+        const auto &it = files.find(fileName);
+        if (it == files.end())
+            return false;
+        currentFile = &it->second;
+        return true;
+    }
+
+    currentFile = &files[fileName];
+    if (fileMode == FileMode::WRITE)
+        currentFile->clear();
+    return true;
+}
+
+OpenResult MemoryStorageMedium::openFileIfExists(const String &fileName)
+{
+    return openFile(fileName, FileMode::READ) ? OpenResult::OPENED : OpenResult::NOT_FOUND;
+}
+
+void MemoryStorageMedium::closeFile()
+{
+    currentFile = nullptr;
+}
+
+bool MemoryStorageMedium::existsImpl(const String &fileName)
+{
+    statistics.lookups++;
+    spend(latency.openMicros);
+    return files.find(fileName) != files.end();
+}
+
+bool MemoryStorageMedium::isCompleteImpl(const String &fileName, const std::vector<ParameterInfo> &parameters)
+{
+    const auto &fileIt = files.find(fileName);
+    if (fileIt == files.end())
+        return false;
+    for (const ParameterInfo &param : parameters)
+    {
+        statistics.reads++;
+        spend(latency.readMicros);
+        if (fileIt->second.find(param.name) == fileIt->second.end())
+            return false;
+    }
+    return true;
+}
+
+bool MemoryStorageMedium::deleteImpl(const String &fileName)
+{
+    const auto &it = files.find(fileName);
+    if (it == files.end())
+        return false;
+    if (currentFile == &it->second)
+        currentFile = nullptr;
+    files.erase(it);
+    return true;
+}
+
+bool MemoryStorageMedium::readBlobImpl(const String &fileName, std::vector<uint8_t> &data)
+{
+    statistics.opens++;
+    spend(latency.openMicros);
+    const auto &it = blobs.find(fileName);
+    if (it == blobs.end())
+        return false;
+    statistics.reads++;
+    spend(latency.readMicros);
+    data = it->second;
+    return true;
+}
+
+bool MemoryStorageMedium::writeBlobImpl(const String &fileName, const std::vector<uint8_t> &data)
+{
+    statistics.opens++;
+    spend(latency.openMicros);
+    recordWrite(wear.recordOverhead + data.size());
+    blobs[fileName] = data;
+    return true;
+}
+
+bool MemoryStorageMedium::deleteBlobImpl(const String &fileName)
+{
+    return blobs.erase(fileName) != 0;
+}
+
+String MemoryStorageMedium::readString(const String &key, const String defaultValue)
+{
+    const Entry *entry = findEntry(key);
+    if (!entry || entry->type != ValueType::STRING)
+        return defaultValue;
+    return entry->text;
+}
+
+void MemoryStorageMedium::writeString(const String &key, const String value)
+{
+    storeEntry(key, {ValueType::STRING, 0, value}, value.length());
+}
+
+template <typename T>
+T MemoryStorageMedium::readValue(const String &key, const T defaultValue, const ValueType type)
+{
+    const Entry *entry = findEntry(key);
+    if (!entry || entry->type != type)
+        return defaultValue;
+    T value;
+    memcpy(&value, &entry->bits, sizeof(T));
+    return value;
+}
+
+template <typename T>
+void MemoryStorageMedium::writeValue(const String &key, const T value, const ValueType type)
+{
+    static_assert(sizeof(T) <= sizeof(uint64_t), "Value does not fit in an entry");
+    Entry entry = {type, 0, String()};
+    memcpy(&entry.bits, &value, sizeof(T));
+    storeEntry(key, std::move(entry), sizeof(T));
+}
+
+const MemoryStorageMedium::Entry *MemoryStorageMedium::findEntry(const String &key)
+{
+    if (!currentFile)
+        throw std::runtime_error("No file is open!");
+    statistics.reads++;
+    spend(latency.readMicros);
+    const auto &it = currentFile->find(key);
+    return it == currentFile->end() ? nullptr : &it->second;
+}
+
+void MemoryStorageMedium::storeEntry(const String &key, Entry &&entry, const size_t valueSize)
+{
+    if (!currentFile)
+        throw std::runtime_error("No file is open!");
+
+    recordWrite(wear.recordOverhead + key.length() + valueSize);
+    (*currentFile)[key] = std::move(entry);
+}
+
+void MemoryStorageMedium::recordWrite(const uint64_t recordSize)
+{
+    statistics.writes++;
+    statistics.bytesWritten += recordSize;
+    spend(static_cast<uint64_t>(latency.writeMicrosPerByte) * recordSize);
+
+    // Every block the record reaches into must be erased before it is written.
+    const uint64_t firstBlock = (writePosition + wear.eraseBlockSize - 1) / wear.eraseBlockSize;
+    const uint64_t end = writePosition + recordSize;
+    for (uint64_t block = firstBlock; block * wear.eraseBlockSize < end; block++)
+    {
+        eraseCounts[block % wear.eraseBlockCount]++;
+        statistics.erases++;
+    }
+    writePosition = end;
+}
+
+void MemoryStorageMedium::spend(const uint64_t micros)
+{
+    if (micros == 0)
+        return;
+    statistics.simulatedMicros += micros;
+    if (latency.block)
+        delayMicroseconds(micros);
+}
@@ -0,0 +1,178 @@
+#ifndef __H_MEMORY_STORAGE_MEDIUM__
+#define __H_MEMORY_STORAGE_MEDIUM__
+#include <WString.h>
+#include <map>
+#include <stdint.h>
+#include <vector>
+#include "StorageMedium.h"
+
+/**
+ * @brief A RAM-backed reference implementation of `StorageMedium`.
+ *
+ * Values are kept with their type, like NVS does, so reading a key with a different type than it was written with returns the default value.
+ * The medium can simulate the cost of a flash backend: a fixed latency per open and per read, a latency per written byte,
+ * and a log-structured flash region whose erase blocks wear out as data is written into them.
+ * Simulated time is always accounted for in `getStatistics()`, and optionally also spent for real (see `LatencyModel::block`).
+ *
+ * `FileMode::WRITE` replaces the file's content, `FileMode::APPEND` and `FileMode::UPDATE` keep it and replace only the written keys.
+ * Blobs are supported, reading or writing one costs an open and a single read or write (like an NVS blob).
+ *
+ */
+class MemoryStorageMedium : public StorageMedium
+{
+public:
+    /**
+     * @brief The simulated cost of each medium operation, in microseconds.
+     *
+     */
+    struct LatencyModel
+    {
+        uint32_t openMicros = 0;
+        uint32_t readMicros = 0;
+        uint32_t writeMicrosPerByte = 0;
+        /// @brief Whether to actually wait for the simulated latency, instead of only accounting for it.
+        bool block = false;
+    };
+
+    /**
+     * @brief The layout of the simulated flash region that records are written into.
+     *
+     * Records are appended to the region, wrapping around at the end, and a block is erased every time the write position enters it.
+     *
+     */
+    struct WearModel
+    {
+        uint32_t eraseBlockSize = 4096;
+        uint32_t eraseBlockCount = 16;
+        /// @brief Bytes of metadata stored with every record, on top of the key and the value.
+        uint32_t recordOverhead = 8;
+    };
+
+    struct Statistics
+    {
+        /// @brief Checks whether a file exists, each one costs as much as an open.
+        uint32_t lookups;
+        uint32_t opens;
+        uint32_t reads;
+        uint32_t writes;
+        uint64_t bytesWritten;
+        uint32_t erases;
+        /// @brief Total latency of the operations so far, according to the latency model.
+        uint64_t simulatedMicros;
+    };
+
+    MemoryStorageMedium() : MemoryStorageMedium(LatencyModel(), WearModel()) {}
+    MemoryStorageMedium(const LatencyModel &latency, const WearModel &wear);
+
+    Statistics getStatistics() const { return statistics; }
+
+    /**
+     * @brief The number of times each erase block of the simulated flash region was erased.
+     */
+    const std::vector<uint32_t> &getEraseCounts() const { return eraseCounts; }
+    uint32_t getMaxEraseCount() const;
+
+    /**
+     * @brief Resets the statistics and the erase counters, keeps the stored files.
+     */
+    void resetStatistics();
+
+    /**
+     * @brief Removes all the files from the medium.
+     */
+    void clear();
+
+protected:
+    bool openFile(const String &fileName, const FileMode fileMode) override;
+    void closeFile() override;
+    OpenResult openFileIfExists(const String &fileName) override;
+
+    bool existsImpl(const String &fileName) override;
+    bool isCompleteImpl(const String &fileName, const std::vector<ParameterInfo> &parameters) override;
+    bool deleteImpl(const String &fileName) override;
+
+    bool supportsUpdateImpl() override { return true; }
+    bool handlesMissingFilesImpl() override { return true; }
+
+    bool readBlobImpl(const String &fileName, std::vector<uint8_t> &data) override;
+    bool writeBlobImpl(const String &fileName, const std::vector<uint8_t> &data) override;
+    bool deleteBlobImpl(const String &fileName) override;
+
+#pragma region Read and Write functions
+    int8_t readChar(const String &key, const int8_t defaultValue) override { return readValue(key, defaultValue, ValueType::CHAR); }
+    uint8_t readUChar(const String &key, const uint8_t defaultValue) override { return readValue(key, defaultValue, ValueType::UCHAR); }
+    int16_t readShort(const String &key, const int16_t defaultValue) override { return readValue(key, defaultValue, ValueType::SHORT); }
+    uint16_t readUShort(const String &key, const uint16_t defaultValue) override { return readValue(key, defaultValue, ValueType::USHORT); }
+    int32_t readInt(const String &key, const int32_t defaultValue) override { return readValue(key, defaultValue, ValueType::INT); }
+    uint32_t readUInt(const String &key, const uint32_t defaultValue) override { return readValue(key, defaultValue, ValueType::UINT); }
+    int64_t readLong(const String &key, const int64_t defaultValue) override { return readValue(key, defaultValue, ValueType::LONG); }
+    uint64_t readULong(const String &key, const uint64_t defaultValue) override { return readValue(key, defaultValue, ValueType::ULONG); }
+    float readFloat(const String &key, const float defaultValue) override { return readValue(key, defaultValue, ValueType::FLOAT); }
+    double readDouble(const String &key, const double defaultValue) override { return readValue(key, defaultValue, ValueType::DOUBLE); }
+    bool readBool(const String &key, const bool defaultValue) override { return readValue(key, defaultValue, ValueType::BOOL); }
+    String readString(const String &key, const String defaultValue) override;
+
+    void writeChar(const String &key, const int8_t value) override { writeValue(key, value, ValueType::CHAR); }
+    void writeUChar(const String &key, const uint8_t value) override { writeValue(key, value, ValueType::UCHAR); }
+    void writeShort(const String &key, const int16_t value) override { writeValue(key, value, ValueType::SHORT); }
+    void writeUShort(const String &key, const uint16_t value) override { writeValue(key, value, ValueType::USHORT); }
+    void writeInt(const String &key, const int32_t value) override { writeValue(key, value, ValueType::INT); }
+    void writeUInt(const String &key, const uint32_t value) override { writeValue(key, value, ValueType::UINT); }
+    void writeLong(const String &key, const int64_t value) override { writeValue(key, value, ValueType::LONG); }
+    void writeULong(const String &key, const uint64_t value) override { writeValue(key, value, ValueType::ULONG); }
+    void writeFloat(const String &key, const float value) override { writeValue(key, value, ValueType::FLOAT); }
+    void writeDouble(const String &key, const double value) override { writeValue(key, value, ValueType::DOUBLE); }
+    void writeBool(const String &key, const bool value) override { writeValue(key, value, ValueType::BOOL); }
+    void writeString(const String &key, const String value) override;
+#pragma endregion
+
+private:
+    enum class ValueType : uint8_t
+    {
+        CHAR,
+        UCHAR,
+        SHORT,
+        USHORT,
+        INT,
+        UINT,
+        LONG,
+        ULONG,
+        FLOAT,
+        DOUBLE,
+        BOOL,
+        STRING,
+    };
+
+    struct Entry
+    {
+        ValueType type;
+        /// @brief The value's bytes, for all types except `ValueType::STRING`.
+        uint64_t bits;
+        String text;
+    };
+
+    typedef std::map<String, Entry> File;
+
+    const LatencyModel latency;
+    const WearModel wear;
+    std::map<String, File> files;
+    std::map<String, std::vector<uint8_t>> blobs;
+    File *currentFile;
+    Statistics statistics;
+    std::vector<uint32_t> eraseCounts;
+    /// @brief Offset of the next record in the simulated flash region.
+    uint64_t writePosition;
+
+    template <typename T>
+    T readValue(const String &key, const T defaultValue, const ValueType type);
+
+    template <typename T>
+    void writeValue(const String &key, const T value, const ValueType type);
+
+    const Entry *findEntry(const String &key);
+    void storeEntry(const String &key, Entry &&entry, const size_t valueSize);
+    void recordWrite(const uint64_t recordSize);
+    void spend(const uint64_t micros);
+};
+
+#endif // __H_MEMORY_STORAGE_MEDIUM__
@@ -1,4 +1,5 @@
 #include "StorageMedium.h"
+#include "internal/StagedValue.h"
 
 #pragma region Template implementations for read and write functions.
 template <>
@@ -36,24 +37,12 @@ int32_t StorageMedium::read<int32_t>(const String &key, const int32_t defaultVal
   return readInt(key, defaultValue);
 }
 
-template <>
-int StorageMedium::read<int>(const String &key, const int defaultValue)
-{
-  return readInt(key, defaultValue);
-}
-
 template <>
 uint32_t StorageMedium::read<uint32_t>(const String &key, const uint32_t defaultValue)
 {
   return readUInt(key, defaultValue);
 }
 
-template <>
-uint StorageMedium::read<uint>(const String &key, const uint defaultValue)
-{
-  return readUInt(key, defaultValue);
-}
-
 template <>
 int64_t StorageMedium::read<int64_t>(const String &key, const int64_t defaultValue)
 {
@@ -163,6 +152,109 @@ void StorageMedium::write<String>(const String &key, const String value)
 }
 #pragma endregion
 
+#pragma region Batches
+size_t StorageMedium::BatchEntry::getValueSize() const
+{
+  return type == Type::STRING ? getValue<String>().length() : StagedValue::getSize(type);
+}
+
+void StorageMedium::readBatch(const BatchEntry *entries, const size_t count)
+{
+  for (size_t i = 0; i < count; i++)
+  {
+    const BatchEntry &entry = entries[i];
+    const String &key = entry.getKey();
+    switch (entry.getType())
+    {
+    case BatchEntry::Type::CHAR:
+      entry.getValue<int8_t>() = readChar(key, entry.getValue<int8_t>());
+      break;
+    case BatchEntry::Type::UCHAR:
+      entry.getValue<uint8_t>() = readUChar(key, entry.getValue<uint8_t>());
+      break;
+    case BatchEntry::Type::SHORT:
+      entry.getValue<int16_t>() = readShort(key, entry.getValue<int16_t>());
+      break;
+    case BatchEntry::Type::USHORT:
+      entry.getValue<uint16_t>() = readUShort(key, entry.getValue<uint16_t>());
+      break;
+    case BatchEntry::Type::INT:
+      entry.getValue<int32_t>() = readInt(key, entry.getValue<int32_t>());
+      break;
+    case BatchEntry::Type::UINT:
+      entry.getValue<uint32_t>() = readUInt(key, entry.getValue<uint32_t>());
+      break;
+    case BatchEntry::Type::LONG:
+      entry.getValue<int64_t>() = readLong(key, entry.getValue<int64_t>());
+      break;
+    case BatchEntry::Type::ULONG:
+      entry.getValue<uint64_t>() = readULong(key, entry.getValue<uint64_t>());
+      break;
+    case BatchEntry::Type::FLOAT:
+      entry.getValue<float>() = readFloat(key, entry.getValue<float>());
+      break;
+    case BatchEntry::Type::DOUBLE:
+      entry.getValue<double>() = readDouble(key, entry.getValue<double>());
+      break;
+    case BatchEntry::Type::BOOL:
+      entry.getValue<bool>() = readBool(key, entry.getValue<bool>());
+      break;
+    case BatchEntry::Type::STRING:
+      entry.getValue<String>() = readString(key, entry.getValue<String>());
+      break;
+    }
+  }
+}
+
+void StorageMedium::writeBatch(const BatchEntry *entries, const size_t count)
+{
+  for (size_t i = 0; i < count; i++)
+  {
+    const BatchEntry &entry = entries[i];
+    const String &key = entry.getKey();
+    switch (entry.getType())
+    {
+    case BatchEntry::Type::CHAR:
+      writeChar(key, entry.getValue<int8_t>());
+      break;
+    case BatchEntry::Type::UCHAR:
+      writeUChar(key, entry.getValue<uint8_t>());
+      break;
+    case BatchEntry::Type::SHORT:
+      writeShort(key, entry.getValue<int16_t>());
+      break;
+    case BatchEntry::Type::USHORT:
+      writeUShort(key, entry.getValue<uint16_t>());
+      break;
+    case BatchEntry::Type::INT:
+      writeInt(key, entry.getValue<int32_t>());
+      break;
+    case BatchEntry::Type::UINT:
+      writeUInt(key, entry.getValue<uint32_t>());
+      break;
+    case BatchEntry::Type::LONG:
+      writeLong(key, entry.getValue<int64_t>());
+      break;
+    case BatchEntry::Type::ULONG:
+      writeULong(key, entry.getValue<uint64_t>());
+      break;
+    case BatchEntry::Type::FLOAT:
+      writeFloat(key, entry.getValue<float>());
+      break;
+    case BatchEntry::Type::DOUBLE:
+      writeDouble(key, entry.getValue<double>());
+      break;
+    case BatchEntry::Type::BOOL:
+      writeBool(key, entry.getValue<bool>());
+      break;
+    case BatchEntry::Type::STRING:
+      writeString(key, entry.getValue<String>());
+      break;
+    }
+  }
+}
+#pragma endregion
+
 bool StorageMedium::exists(const String &fileName)
 {
   if (fileName.isEmpty())
@@ -172,18 +264,39 @@ bool StorageMedium::exists(const String &fileName)
 
 bool StorageMedium::isComplete(const String &fileName, const std::vector<ParameterInfo> &parameters)
 {
-  if (fileName.isEmpty() || !exists(fileName))
+  if (fileName.isEmpty() || (!handlesMissingFilesImpl() && !existsImpl(fileName)))
     return false;
   return isCompleteImpl(fileName, parameters);
 }
 
 bool StorageMedium::deleteConfig(const String &fileName)
 {
-  if (fileName.isEmpty() || !exists(fileName))
+  if (fileName.isEmpty() || (!handlesMissingFilesImpl() && !existsImpl(fileName)))
     return false;
   return deleteImpl(fileName);
 }
 
+bool StorageMedium::readBlob(const String &fileName, std::vector<uint8_t> &data)
+{
+  if (fileName.isEmpty())
+    return false;
+  return readBlobImpl(fileName, data);
+}
+
+bool StorageMedium::writeBlob(const String &fileName, const std::vector<uint8_t> &data)
+{
+  if (fileName.isEmpty())
+    return false;
+  return writeBlobImpl(fileName, data);
+}
+
+bool StorageMedium::deleteBlob(const String &fileName)
+{
+  if (fileName.isEmpty())
+    return false;
+  return deleteBlobImpl(fileName);
+}
+
 StorageMedium::FileHandler StorageMedium::createFileHandler(const String &fileName, const FileMode fileMode)
 {
   bool isOpen = openFile(fileName, fileMode);
@@ -191,3 +304,18 @@ StorageMedium::FileHandler StorageMedium::createFileHandler(const String &fileNa
                       { closeFile(); });
   return handler;
 }
+
+StorageMedium::FileHandler StorageMedium::openIfExists(const String &fileName)
+{
+  const OpenResult result = fileName.isEmpty() ? OpenResult::NOT_FOUND : openFileIfExists(fileName);
+  FileHandler handler(*this, result == OpenResult::OPENED, [this]()
+                      { closeFile(); }, result != OpenResult::NOT_FOUND);
+  return handler;
+}
+
+OpenResult StorageMedium::openFileIfExists(const String &fileName)
+{
+  if (!existsImpl(fileName))
+    return OpenResult::NOT_FOUND;
+  return openFile(fileName, FileMode::READ) ? OpenResult::OPENED : OpenResult::FAILED;
+}
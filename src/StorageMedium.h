@@ -3,14 +3,34 @@
 #include <WString.h>
 #include <stdexcept>
 #include <stdint.h>
+#include <type_traits>
 #include <vector>
 #include "DataStructures.h"
 
 enum class FileMode : uint8_t
 {
+  /// @brief Open an existing file for reading.
   READ,
+  /// @brief Open a file for writing, replacing its content.
   WRITE,
-  APPEND
+  /// @brief Open a file for writing, keeping its content. How the written keys are added is up to the medium (e.g. a log-structured file appends a new record).
+  APPEND,
+  /// @brief Open a file for writing, keeping its content: written keys are replaced and the other keys keep their values.
+  /// Only for mediums that support it (see `StorageMedium::supportsUpdate`).
+  UPDATE
+};
+
+/**
+ * @brief The outcome of opening a file only if it exists.
+ */
+enum class OpenResult : uint8_t
+{
+  /// @brief The file exists and is open for reading.
+  OPENED,
+  /// @brief The file does not exist.
+  NOT_FOUND,
+  /// @brief The file exists but could not be opened.
+  FAILED
 };
 
 /**
@@ -21,7 +41,90 @@ enum class FileMode : uint8_t
  */
 class StorageMedium
 {
+  // Decorators forward the protected operations to the medium they wrap.
+  friend class StorageMediumDecorator;
+
 public:
+  /**
+   * @brief A key to read or write in a batch (see `FileHandler::readBatch` and `FileHandler::writeBatch`), and the variable that holds its value.
+   * When reading, the variable's current value is the default value, and it is replaced by the stored value.
+   *
+   */
+  class BatchEntry
+  {
+  public:
+    enum class Type : uint8_t
+    {
+      CHAR,
+      UCHAR,
+      SHORT,
+      USHORT,
+      INT,
+      UINT,
+      LONG,
+      ULONG,
+      FLOAT,
+      DOUBLE,
+      BOOL,
+      STRING,
+    };
+
+    /**
+     * @param key The key, must outlive the entry.
+     * @param value The variable that receives the value when reading, must outlive the entry.
+     */
+    template <typename T>
+    BatchEntry(const String &key, T *value) : key(&key), type(typeOf<T>()), value(value) {}
+
+    /**
+     * @param key The key, must outlive the entry.
+     * @param value The variable that holds the value to write, must outlive the entry (such entries must not be read into).
+     */
+    template <typename T>
+    BatchEntry(const String &key, const T *value) : key(&key), type(typeOf<T>()), value(const_cast<T *>(value)) {}
+
+    const String &getKey() const { return *key; }
+    Type getType() const { return type; }
+
+    /**
+     * @brief The variable that holds the value, `T` must be the fixed-width type that matches `getType()` (`int8_t` for `Type::CHAR`, ...).
+     */
+    template <typename T>
+    T &getValue() const { return *static_cast<T *>(value); }
+
+    /**
+     * @brief The size of the value in bytes (the length, for strings).
+     */
+    size_t getValueSize() const;
+
+  private:
+    const String *key;
+    Type type;
+    void *value;
+
+    template <typename T>
+    static constexpr Type typeOf()
+    {
+      if constexpr (std::is_same<T, bool>::value)
+        return Type::BOOL;
+      else if constexpr (std::is_same<T, float>::value)
+        return Type::FLOAT;
+      else if constexpr (std::is_same<T, double>::value)
+        return Type::DOUBLE;
+      else if constexpr (std::is_same<T, String>::value)
+        return Type::STRING;
+      else
+      {
+        static_assert(std::is_integral<T>::value, "Type is not supported by the storage medium");
+        // Integer types are stored as the fixed-width type with the same size and signedness, like `read` and `write` do.
+        constexpr Type types[] = {Type::CHAR, Type::UCHAR, Type::SHORT, Type::USHORT, Type::INT, Type::UINT, Type::LONG, Type::ULONG};
+        constexpr size_t sizeIndex = sizeof(T) == 1 ? 0 : sizeof(T) == 2 ? 1 : sizeof(T) == 4 ? 2 : 3;
+        static_assert(sizeof(T) == 1 || sizeof(T) == 2 || sizeof(T) == 4 || sizeof(T) == 8, "Type is not supported by the storage medium");
+        return types[sizeIndex * 2 + (std::is_signed<T>::value || std::is_same<T, char>::value ? 0 : 1)];
+      }
+    }
+  };
+
   /**
    * @brief Instantiated by the StorageMedium, it encapsulates a unified interface for reading from and writing to a file in the associated storage medium.
    * This abstraction simplifies file operations, allowing managing file I/O without needing to handle the underlying storage implementation.
@@ -51,9 +154,69 @@ public:
     {
       if (!*this)
         throw std::runtime_error("Trying to write to a disposed/unopen file!");
+      if (writeFilter && !writeFilter(key))
+        return;
       storageMedium.write<T>(key, value);
     }
 
+    /**
+     * @brief Reads all the given keys in one call to the storage medium, which may read them in a single pass.
+     *
+     * @param entries The keys and the variables that receive their values (their current values are the default values).
+     * @param count The number of entries.
+     */
+    void readBatch(const BatchEntry *entries, const size_t count) const
+    {
+      if (!*this)
+        throw std::runtime_error("Trying to read from a disposed/unopen file!");
+      storageMedium.readBatch(entries, count);
+    }
+    void readBatch(const std::vector<BatchEntry> &entries) const
+    {
+      readBatch(entries.data(), entries.size());
+    }
+
+    /**
+     * @brief Writes all the given keys in one call to the storage medium, which may write them in a single pass.
+     * The write filter applies to each key, as with `write`.
+     *
+     * @param entries The keys and the variables that hold their values.
+     * @param count The number of entries.
+     */
+    void writeBatch(const BatchEntry *entries, const size_t count) const
+    {
+      if (!*this)
+        throw std::runtime_error("Trying to write to a disposed/unopen file!");
+      if (!writeFilter)
+      {
+        storageMedium.writeBatch(entries, count);
+        return;
+      }
+      std::vector<BatchEntry> filtered;
+      filtered.reserve(count);
+      for (size_t i = 0; i < count; i++)
+      {
+        if (writeFilter(entries[i].getKey()))
+          filtered.push_back(entries[i]);
+      }
+      if (!filtered.empty())
+        storageMedium.writeBatch(filtered.data(), filtered.size());
+    }
+    void writeBatch(const std::vector<BatchEntry> &entries) const
+    {
+      writeBatch(entries.data(), entries.size());
+    }
+
+    /**
+     * @brief Restricts the writes through this handler to the keys for which `filter` returns true, writes to other keys are skipped.
+     *
+     * @param filter The predicate, or `nullptr` to write all keys.
+     */
+    void setWriteFilter(const std::function<bool(const String &key)> filter)
+    {
+      writeFilter = filter;
+    }
+
     void dispose()
     {
       if (disposed || !isOpen)
@@ -67,14 +230,25 @@ public:
       return isOpen && !disposed;
     }
 
+    /**
+     * @brief Whether the file was found, `false` only for a handler returned by `openIfExists` for a missing file.
+     * A found file that could not be opened gives a handler that is found but not open.
+     */
+    bool isFound() const
+    {
+      return found;
+    }
+
   private:
-    FileHandler(StorageMedium &storageMedium, const bool isOpen, const std::function<void()> disposeFunc)
-        : storageMedium(storageMedium), isOpen(isOpen), disposeFunc(disposeFunc), disposed(false) {}
+    FileHandler(StorageMedium &storageMedium, const bool isOpen, const std::function<void()> disposeFunc, const bool found = true)
+        : storageMedium(storageMedium), disposeFunc(disposeFunc), isOpen(isOpen), disposed(false), found(found) {}
 
     StorageMedium &storageMedium;
     const std::function<void()> disposeFunc;
     const bool isOpen;
     bool disposed;
+    const bool found;
+    std::function<bool(const String &key)> writeFilter;
   };
 
   /**
@@ -117,14 +291,71 @@ public:
    */
   FileHandler createFileHandler(const String &fileName, const FileMode fileMode);
 
+  /**
+   * @brief Opens the given file for reading if it exists, in a single access to the medium when the medium supports it
+   * (instead of `exists` followed by `createFileHandler`).
+   *
+   * @param fileName The name of the file that you wish to open.
+   * @return FileHandler - Open if the file exists and was opened, not open otherwise; `isFound()` tells a missing file from a failure to open it.
+   */
+  FileHandler openIfExists(const String &fileName);
+
+  /**
+   * @brief Reads the binary blob stored for the given file (e.g. a packed configuration), in a single access.
+   * Blobs are kept apart from the file's keys.
+   *
+   * @param fileName The name of the file whose blob you want to read.
+   * @param data Receives the blob's content.
+   * @return true if the blob was read; false if there is no blob, or the medium does not support blobs.
+   */
+  bool readBlob(const String &fileName, std::vector<uint8_t> &data);
+
+  /**
+   * @brief Writes the binary blob of the given file, replacing the previous one.
+   *
+   * @return true if the blob was written; false if it failed, or the medium does not support blobs.
+   */
+  bool writeBlob(const String &fileName, const std::vector<uint8_t> &data);
+
+  /**
+   * @brief Deletes the binary blob of the given file.
+   *
+   * @return true if the blob was deleted; false if there is no blob, or the medium does not support blobs.
+   */
+  bool deleteBlob(const String &fileName);
+
+  /**
+   * @brief Whether files can be opened with `FileMode::UPDATE`.
+   */
+  bool supportsUpdate() { return supportsUpdateImpl(); }
+
 protected:
   virtual bool openFile(const String &fileName, const FileMode fileMode) = 0;
   virtual void closeFile() = 0;
 
+  /**
+   * @brief Opens an existing file for reading, telling apart a missing file from a failure to open it.
+   * The default implementation checks `existsImpl` and then calls `openFile`, mediums that can do both in one access should override it.
+   */
+  virtual OpenResult openFileIfExists(const String &fileName);
+
+  // `isCompleteImpl` and `deleteImpl` are only called for files that exist (checked first with `existsImpl`),
+  // unless `handlesMissingFilesImpl` returns true.
   virtual bool existsImpl(const String &fileName) = 0;
   virtual bool isCompleteImpl(const String &fileName, const std::vector<ParameterInfo> &parameters) = 0;
   virtual bool deleteImpl(const String &fileName) = 0;
 
+  // Mediums whose `isCompleteImpl` and `deleteImpl` return false for missing files can override this to skip the extra access of `existsImpl`.
+  virtual bool handlesMissingFilesImpl() { return false; }
+
+  // Updating keys in place is an optional capability, mediums that do not override this are never opened with `FileMode::UPDATE`.
+  virtual bool supportsUpdateImpl() { return false; }
+
+  // Blobs are an optional capability, mediums that do not override these do not support them.
+  virtual bool readBlobImpl(const String &fileName, std::vector<uint8_t> &data) { return false; }
+  virtual bool writeBlobImpl(const String &fileName, const std::vector<uint8_t> &data) { return false; }
+  virtual bool deleteBlobImpl(const String &fileName) { return false; }
+
 #pragma region Read and Write abstract functions
   virtual int8_t readChar(const String &key, const int8_t defaultValue) = 0;
   virtual uint8_t readUChar(const String &key, const uint8_t defaultValue) = 0;
@@ -153,12 +384,121 @@ protected:
   virtual void writeString(const String &key, const String value) = 0;
 #pragma endregion
 
+  /**
+   * @brief Reads all the entries (see `FileHandler::readBatch`).
+   * The default implementation reads the keys one by one, mediums that can read many keys in a single pass (e.g. one parse of a file) should override it.
+   */
+  virtual void readBatch(const BatchEntry *entries, const size_t count);
+
+  /**
+   * @brief Writes all the entries (see `FileHandler::writeBatch`).
+   * The default implementation writes the keys one by one, mediums that can write many keys in a single pass should override it.
+   */
+  virtual void writeBatch(const BatchEntry *entries, const size_t count);
+
 private:
   template <typename T>
   T read(const String &key, const T defaultValue = T());
 
   template <typename T>
   void write(const String &key, const T value);
+
+  // Maps an integer type to the fixed-width type with the same size and signedness.
+  template <size_t Size, bool Signed>
+  struct FixedWidthInteger;
 };
 
+#pragma region Fixed width integers mapping
+template <>
+struct StorageMedium::FixedWidthInteger<1, true> { using type = int8_t; };
+template <>
+struct StorageMedium::FixedWidthInteger<1, false> { using type = uint8_t; };
+template <>
+struct StorageMedium::FixedWidthInteger<2, true> { using type = int16_t; };
+template <>
+struct StorageMedium::FixedWidthInteger<2, false> { using type = uint16_t; };
+template <>
+struct StorageMedium::FixedWidthInteger<4, true> { using type = int32_t; };
+template <>
+struct StorageMedium::FixedWidthInteger<4, false> { using type = uint32_t; };
+template <>
+struct StorageMedium::FixedWidthInteger<8, true> { using type = int64_t; };
+template <>
+struct StorageMedium::FixedWidthInteger<8, false> { using type = uint64_t; };
+#pragma endregion
+
+#pragma region Supported types for read and write (implemented in StorageMedium.cpp)
+template <>
+int8_t StorageMedium::read<int8_t>(const String &key, const int8_t defaultValue);
+template <>
+char StorageMedium::read<char>(const String &key, const char defaultValue);
+template <>
+uint8_t StorageMedium::read<uint8_t>(const String &key, const uint8_t defaultValue);
+template <>
+int16_t StorageMedium::read<int16_t>(const String &key, const int16_t defaultValue);
+template <>
+uint16_t StorageMedium::read<uint16_t>(const String &key, const uint16_t defaultValue);
+template <>
+int32_t StorageMedium::read<int32_t>(const String &key, const int32_t defaultValue);
+template <>
+uint32_t StorageMedium::read<uint32_t>(const String &key, const uint32_t defaultValue);
+template <>
+int64_t StorageMedium::read<int64_t>(const String &key, const int64_t defaultValue);
+template <>
+uint64_t StorageMedium::read<uint64_t>(const String &key, const uint64_t defaultValue);
+template <>
+float StorageMedium::read<float>(const String &key, const float defaultValue);
+template <>
+double StorageMedium::read<double>(const String &key, const double defaultValue);
+template <>
+bool StorageMedium::read<bool>(const String &key, const bool defaultValue);
+template <>
+String StorageMedium::read<String>(const String &key, const String defaultValue);
+
+template <>
+void StorageMedium::write<int8_t>(const String &key, const int8_t value);
+template <>
+void StorageMedium::write<uint8_t>(const String &key, const uint8_t value);
+template <>
+void StorageMedium::write<int16_t>(const String &key, const int16_t value);
+template <>
+void StorageMedium::write<uint16_t>(const String &key, const uint16_t value);
+template <>
+void StorageMedium::write<int32_t>(const String &key, const int32_t value);
+template <>
+void StorageMedium::write<uint32_t>(const String &key, const uint32_t value);
+template <>
+void StorageMedium::write<int64_t>(const String &key, const int64_t value);
+template <>
+void StorageMedium::write<uint64_t>(const String &key, const uint64_t value);
+template <>
+void StorageMedium::write<float>(const String &key, const float value);
+template <>
+void StorageMedium::write<double>(const String &key, const double value);
+template <>
+void StorageMedium::write<bool>(const String &key, const bool value);
+template <>
+void StorageMedium::write<String>(const String &key, const String value);
+#pragma endregion
+
+/**
+ * Integer types without a dedicated specialization (`int`, `uint`, `long`, ...) are forwarded to the fixed-width type of the same size,
+ * whether or not that fixed-width type is the same type on the current platform.
+ */
+template <typename T>
+T StorageMedium::read(const String &key, const T defaultValue)
+{
+  static_assert(std::is_integral<T>::value, "Type is not supported by the storage medium");
+  using Fixed = typename FixedWidthInteger<sizeof(T), std::is_signed<T>::value>::type;
+  return static_cast<T>(read<Fixed>(key, static_cast<Fixed>(defaultValue)));
+}
+
+template <typename T>
+void StorageMedium::write(const String &key, const T value)
+{
+  static_assert(std::is_integral<T>::value, "Type is not supported by the storage medium");
+  using Fixed = typename FixedWidthInteger<sizeof(T), std::is_signed<T>::value>::type;
+  write<Fixed>(key, static_cast<Fixed>(value));
+}
+
 #endif // __H_STORAGE_MEDIUM__
@@ -0,0 +1,73 @@
+#ifndef __H_STORAGE_MEDIUM_DECORATOR__
+#define __H_STORAGE_MEDIUM_DECORATOR__
+#include <WString.h>
+#include <vector>
+#include "StorageMedium.h"
+
+/**
+ * @brief Base class for storage mediums that wrap another storage medium, adding behavior on top of it (instrumentation, caching, ...).
+ *
+ * Every operation is forwarded as-is to the inner medium, derived classes override only the operations they want to intercept,
+ * and call the decorator's implementation to reach the inner medium.
+ *
+ */
+class StorageMediumDecorator : public StorageMedium
+{
+public:
+    StorageMediumDecorator(StorageMedium &inner) : inner(inner) {}
+
+protected:
+    StorageMedium &getInner() { return inner; }
+
+    bool openFile(const String &fileName, const FileMode fileMode) override { return inner.openFile(fileName, fileMode); }
+    void closeFile() override { inner.closeFile(); }
+    OpenResult openFileIfExists(const String &fileName) override { return inner.openFileIfExists(fileName); }
+
+    bool existsImpl(const String &fileName) override { return inner.existsImpl(fileName); }
+    bool isCompleteImpl(const String &fileName, const std::vector<ParameterInfo> &parameters) override { return inner.isCompleteImpl(fileName, parameters); }
+    bool deleteImpl(const String &fileName) override { return inner.deleteImpl(fileName); }
+    bool handlesMissingFilesImpl() override { return inner.handlesMissingFilesImpl(); }
+
+    bool supportsUpdateImpl() override { return inner.supportsUpdateImpl(); }
+
+    bool readBlobImpl(const String &fileName, std::vector<uint8_t> &data) override { return inner.readBlobImpl(fileName, data); }
+    bool writeBlobImpl(const String &fileName, const std::vector<uint8_t> &data) override { return inner.writeBlobImpl(fileName, data); }
+    bool deleteBlobImpl(const String &fileName) override { return inner.deleteBlobImpl(fileName); }
+
+#pragma region Read and Write functions
+    int8_t readChar(const String &key, const int8_t defaultValue) override { return inner.readChar(key, defaultValue); }
+    uint8_t readUChar(const String &key, const uint8_t defaultValue) override { return inner.readUChar(key, defaultValue); }
+    int16_t readShort(const String &key, const int16_t defaultValue) override { return inner.readShort(key, defaultValue); }
+    uint16_t readUShort(const String &key, const uint16_t defaultValue) override { return inner.readUShort(key, defaultValue); }
+    int32_t readInt(const String &key, const int32_t defaultValue) override { return inner.readInt(key, defaultValue); }
+    uint32_t readUInt(const String &key, const uint32_t defaultValue) override { return inner.readUInt(key, defaultValue); }
+    int64_t readLong(const String &key, const int64_t defaultValue) override { return inner.readLong(key, defaultValue); }
+    uint64_t readULong(const String &key, const uint64_t defaultValue) override { return inner.readULong(key, defaultValue); }
+    float readFloat(const String &key, const float defaultValue) override { return inner.readFloat(key, defaultValue); }
+    double readDouble(const String &key, const double defaultValue) override { return inner.readDouble(key, defaultValue); }
+    bool readBool(const String &key, const bool defaultValue) override { return inner.readBool(key, defaultValue); }
+    String readString(const String &key, const String defaultValue) override { return inner.readString(key, defaultValue); }
+
+    void writeChar(const String &key, const int8_t value) override { inner.writeChar(key, value); }
+    void writeUChar(const String &key, const uint8_t value) override { inner.writeUChar(key, value); }
+    void writeShort(const String &key, const int16_t value) override { inner.writeShort(key, value); }
+    void writeUShort(const String &key, const uint16_t value) override { inner.writeUShort(key, value); }
+    void writeInt(const String &key, const int32_t value) override { inner.writeInt(key, value); }
+    void writeUInt(const String &key, const uint32_t value) override { inner.writeUInt(key, value); }
+    void writeLong(const String &key, const int64_t value) override { inner.writeLong(key, value); }
+    void writeULong(const String &key, const uint64_t value) override { inner.writeULong(key, value); }
+    void writeFloat(const String &key, const float value) override { inner.writeFloat(key, value); }
+    void writeDouble(const String &key, const double value) override { inner.writeDouble(key, value); }
+    void writeBool(const String &key, const bool value) override { inner.writeBool(key, value); }
+    void writeString(const String &key, const String value) override { inner.writeString(key, value); }
+#pragma endregion
+
+    // Batches go to the inner medium's batch functions, so decorators that intercept single reads or writes must also override these.
+    void readBatch(const BatchEntry *entries, const size_t count) override { inner.readBatch(entries, count); }
+    void writeBatch(const BatchEntry *entries, const size_t count) override { inner.writeBatch(entries, count); }
+
+private:
+    StorageMedium &inner;
+};
+
+#endif // __H_STORAGE_MEDIUM_DECORATOR__
@@ -0,0 +1,175 @@
+#include <Arduino.h>
+#include <HardwareSerial.h>
+#include <stdexcept>
+#include "WriteBackStorageMedium.h"
+
+WriteBackStorageMedium::WriteBackStorageMedium(StorageMedium &inner, const unsigned long flushIntervalMs)
+    : StorageMediumDecorator(inner), flushIntervalMs(flushIntervalMs), files(), pendingSinceMs(0), currentFileName(),
+      currentFile(nullptr), innerOpen(false), fileOpen(false), flushRequested(false) {}
+
+WriteBackStorageMedium::~WriteBackStorageMedium()
+{
+    try
+    {
+        flush();
+    }
+    catch (const std::exception &e)
+    {
+        Serial.printf("Error flushing the pending writes: %s\n", e.what());
+    }
+}
+
+void WriteBackStorageMedium::flush()
+{
+    if (fileOpen)
+    {
+        flushRequested = true;
+        return;
+    }
+    flushRequested = false;
+    while (!files.empty())
+        flushFile(files.begin()->first);
+}
+
+void WriteBackStorageMedium::loop()
+{
+    if (fileOpen)
+        return;
+    if (flushRequested)
+        flush();
+    else
+        flushIfDue();
+}
+
+size_t WriteBackStorageMedium::getPendingCount() const
+{
+    size_t count = 0;
+    for (const auto &[fileName, file] : files)
+        count += file.values.size();
+    return count;
+}
+
+bool WriteBackStorageMedium::openFile(const String &fileName, const FileMode fileMode)
+{
+    currentFileName = fileName;
+    innerOpen = false;
+    if (fileMode == FileMode::READ)
+    {
+        const auto &it = files.find(fileName);
+        currentFile = it == files.end() ? nullptr : &it->second;
+        // A file that will be cleared has nothing to read on the inner medium.
+        if (currentFile == nullptr || currentFile->mode != FileMode::WRITE)
+            innerOpen = StorageMediumDecorator::openFile(fileName, fileMode);
+        fileOpen = innerOpen || currentFile != nullptr;
+        return fileOpen;
+    }
+
+    // Opening the file on the inner medium is deferred to the flush.
+    currentFile = &getPendingFile(fileName);
+    if (fileMode == FileMode::WRITE)
+        currentFile->values.clear();
+    // A file that will be cleared stays so.
+    if (currentFile->mode != FileMode::WRITE)
+        currentFile->mode = fileMode;
+    fileOpen = true;
+    return true;
+}
+
+void WriteBackStorageMedium::closeFile()
+{
+    if (innerOpen)
+        StorageMediumDecorator::closeFile();
+    innerOpen = false;
+    currentFile = nullptr;
+    fileOpen = false;
+    // Not flushed here: closing runs from the file handler's destructor, which must not throw.
+}
+
+OpenResult WriteBackStorageMedium::openFileIfExists(const String &fileName)
+{
+    if (files.find(fileName) != files.end())
+        return openFile(fileName, FileMode::READ) ? OpenResult::OPENED : OpenResult::FAILED;
+    const OpenResult result = StorageMediumDecorator::openFileIfExists(fileName);
+    currentFileName = fileName;
+    currentFile = nullptr;
+    innerOpen = fileOpen = result == OpenResult::OPENED;
+    return result;
+}
+
+bool WriteBackStorageMedium::existsImpl(const String &fileName)
+{
+    return files.find(fileName) != files.end() || StorageMediumDecorator::existsImpl(fileName);
+}
+
+bool WriteBackStorageMedium::isCompleteImpl(const String &fileName, const std::vector<ParameterInfo> &parameters)
+{
+    // The pending keys and the stored ones are checked together once they are all stored.
+    if (!fileOpen)
+        flushFile(fileName);
+    return StorageMediumDecorator::isCompleteImpl(fileName, parameters);
+}
+
+bool WriteBackStorageMedium::deleteImpl(const String &fileName)
+{
+    const auto &it = files.find(fileName);
+    const bool pending = it != files.end();
+    if (pending)
+    {
+        if (currentFile == &it->second)
+            currentFile = nullptr;
+        files.erase(it);
+    }
+    // A file that was only written through this medium has nothing to delete on the inner medium.
+    if (!StorageMediumDecorator::existsImpl(fileName))
+        return pending;
+    return StorageMediumDecorator::deleteImpl(fileName) || pending;
+}
+
+void WriteBackStorageMedium::writeBatch(const BatchEntry *entries, const size_t count)
+{
+    for (size_t i = 0; i < count; i++)
+        stage(entries[i]);
+}
+
+WriteBackStorageMedium::PendingFile &WriteBackStorageMedium::getPendingFile(const String &fileName)
+{
+    if (files.empty())
+        pendingSinceMs = millis();
+    return files[fileName];
+}
+
+void WriteBackStorageMedium::stage(const BatchEntry &entry)
+{
+    if (!fileOpen)
+        return;
+    if (currentFile == nullptr)
+        currentFile = &getPendingFile(currentFileName);
+    currentFile->values.insert_or_assign(entry.getKey(), StagedValue(entry));
+}
+
+void WriteBackStorageMedium::flushFile(const String &fileName)
+{
+    const auto &it = files.find(fileName);
+    if (it == files.end())
+        return;
+    const PendingFile &file = it->second;
+    std::vector<BatchEntry> entries;
+    entries.reserve(file.values.size());
+    for (const auto &[key, value] : file.values)
+        entries.push_back(value.getEntry(key));
+
+    if (!StorageMediumDecorator::openFile(fileName, file.mode))
+    {
+        Serial.printf("Error opening file: \"%s\"\n", fileName.c_str());
+        throw std::runtime_error("Error opening file!");
+    }
+    StorageMediumDecorator::writeBatch(entries.data(), entries.size());
+    StorageMediumDecorator::closeFile();
+    files.erase(it);
+}
+
+void WriteBackStorageMedium::flushIfDue()
+{
+    if (flushIntervalMs != 0 && !files.empty() && millis() - pendingSinceMs >= flushIntervalMs)
+        flush();
+}
@@ -0,0 +1,139 @@
+#ifndef __H_WRITE_BACK_STORAGE_MEDIUM__
+#define __H_WRITE_BACK_STORAGE_MEDIUM__
+#include <WString.h>
+#include <map>
+#include <stdint.h>
+#include <vector>
+#include "StorageMediumDecorator.h"
+#include "internal/StagedValue.h"
+
+/**
+ * @brief A storage medium that keeps the writes made through it in RAM, per file, and writes them to another medium later, in one batch per file.
+ *
+ * Writing a key that is already pending replaces its value, so a value that is updated often (a counter, a calibration value)
+ * is written once per flush instead of once per update. The pending writes are flushed:
+ * - when `flush` is called,
+ * - when the oldest of them is older than the flush interval, checked by `loop`,
+ * - when the medium is destroyed.
+ *
+ * Reads see the pending values, `exists` sees the pending files, and `isComplete` flushes the file before checking it.
+ * Opening a file with `FileMode::WRITE` discards its pending values, and the file is cleared when it is flushed.
+ * Otherwise the file is flushed with the mode it was last opened with (`FileMode::APPEND` or `FileMode::UPDATE`), so the inner medium's semantics are kept.
+ * Pending writes are lost on a reset, use it for values that can be recomputed or whose latest updates may be lost.
+ *
+ */
+class WriteBackStorageMedium : public StorageMediumDecorator
+{
+public:
+    /**
+     * @param inner The medium the writes are flushed to.
+     * @param flushIntervalMs The maximum time a write stays pending, `0` to flush only explicitly (and on destruction).
+     */
+    WriteBackStorageMedium(StorageMedium &inner, const unsigned long flushIntervalMs = 0);
+    ~WriteBackStorageMedium();
+
+    /**
+     * @brief Writes all the pending values to the inner medium, in one batch per file.
+     * If a file is open through this medium, the flush is left to the next call to `loop` after it is closed.
+     * Throws `std::runtime_error` if a file cannot be opened on the inner medium (its values stay pending).
+     */
+    void flush();
+
+    /**
+     * @brief Flushes the pending values if the flush interval elapsed or a flush was requested while a file was open, call it from the sketch's `loop()`.
+     * Throws `std::runtime_error` like `flush`.
+     */
+    void loop();
+
+    /**
+     * @brief The number of values waiting to be written.
+     */
+    size_t getPendingCount() const;
+
+protected:
+    bool openFile(const String &fileName, const FileMode fileMode) override;
+    void closeFile() override;
+    OpenResult openFileIfExists(const String &fileName) override;
+
+    bool existsImpl(const String &fileName) override;
+    bool isCompleteImpl(const String &fileName, const std::vector<ParameterInfo> &parameters) override;
+    bool deleteImpl(const String &fileName) override;
+
+#pragma region Read and Write functions
+    int8_t readChar(const String &key, const int8_t defaultValue) override { return readValue(key, defaultValue, [&]() { return StorageMediumDecorator::readChar(key, defaultValue); }); }
+    uint8_t readUChar(const String &key, const uint8_t defaultValue) override { return readValue(key, defaultValue, [&]() { return StorageMediumDecorator::readUChar(key, defaultValue); }); }
+    int16_t readShort(const String &key, const int16_t defaultValue) override { return readValue(key, defaultValue, [&]() { return StorageMediumDecorator::readShort(key, defaultValue); }); }
+    uint16_t readUShort(const String &key, const uint16_t defaultValue) override { return readValue(key, defaultValue, [&]() { return StorageMediumDecorator::readUShort(key, defaultValue); }); }
+    int32_t readInt(const String &key, const int32_t defaultValue) override { return readValue(key, defaultValue, [&]() { return StorageMediumDecorator::readInt(key, defaultValue); }); }
+    uint32_t readUInt(const String &key, const uint32_t defaultValue) override { return readValue(key, defaultValue, [&]() { return StorageMediumDecorator::readUInt(key, defaultValue); }); }
+    int64_t readLong(const String &key, const int64_t defaultValue) override { return readValue(key, defaultValue, [&]() { return StorageMediumDecorator::readLong(key, defaultValue); }); }
+    uint64_t readULong(const String &key, const uint64_t defaultValue) override { return readValue(key, defaultValue, [&]() { return StorageMediumDecorator::readULong(key, defaultValue); }); }
+    float readFloat(const String &key, const float defaultValue) override { return readValue(key, defaultValue, [&]() { return StorageMediumDecorator::readFloat(key, defaultValue); }); }
+    double readDouble(const String &key, const double defaultValue) override { return readValue(key, defaultValue, [&]() { return StorageMediumDecorator::readDouble(key, defaultValue); }); }
+    bool readBool(const String &key, const bool defaultValue) override { return readValue(key, defaultValue, [&]() { return StorageMediumDecorator::readBool(key, defaultValue); }); }
+    String readString(const String &key, const String defaultValue) override { return readValue(key, defaultValue, [&]() { return StorageMediumDecorator::readString(key, defaultValue); }); }
+
+    void writeChar(const String &key, const int8_t value) override { stage(BatchEntry(key, &value)); }
+    void writeUChar(const String &key, const uint8_t value) override { stage(BatchEntry(key, &value)); }
+    void writeShort(const String &key, const int16_t value) override { stage(BatchEntry(key, &value)); }
+    void writeUShort(const String &key, const uint16_t value) override { stage(BatchEntry(key, &value)); }
+    void writeInt(const String &key, const int32_t value) override { stage(BatchEntry(key, &value)); }
+    void writeUInt(const String &key, const uint32_t value) override { stage(BatchEntry(key, &value)); }
+    void writeLong(const String &key, const int64_t value) override { stage(BatchEntry(key, &value)); }
+    void writeULong(const String &key, const uint64_t value) override { stage(BatchEntry(key, &value)); }
+    void writeFloat(const String &key, const float value) override { stage(BatchEntry(key, &value)); }
+    void writeDouble(const String &key, const double value) override { stage(BatchEntry(key, &value)); }
+    void writeBool(const String &key, const bool value) override { stage(BatchEntry(key, &value)); }
+    void writeString(const String &key, const String value) override { stage(BatchEntry(key, &value)); }
+#pragma endregion
+
+    // Key by key, through the functions above.
+    void readBatch(const BatchEntry *entries, const size_t count) override { StorageMedium::readBatch(entries, count); }
+    void writeBatch(const BatchEntry *entries, const size_t count) override;
+
+private:
+    struct PendingFile
+    {
+        /// @brief The mode the file is opened with on the inner medium, `FileMode::WRITE` if it must be cleared before its values are written.
+        FileMode mode = FileMode::APPEND;
+        std::map<String, StagedValue> values;
+    };
+
+    const unsigned long flushIntervalMs;
+    std::map<String, PendingFile> files;
+    /// @brief When the oldest pending value was written.
+    unsigned long pendingSinceMs;
+    String currentFileName;
+    /// @brief The pending writes of the open file (points into `files`), `nullptr` if it has none.
+    PendingFile *currentFile;
+    /// @brief Whether the open file is open on the inner medium (files opened for writing are not).
+    bool innerOpen;
+    /// @brief Whether a file is open through this medium.
+    bool fileOpen;
+    /// @brief Whether `flush` was called while a file was open, the next `loop` flushes then.
+    bool flushRequested;
+
+    template <typename T, typename Func>
+    T readValue(const String &key, const T defaultValue, Func &&readInner)
+    {
+        if (currentFile != nullptr)
+        {
+            const auto &it = currentFile->values.find(key);
+            if (it != currentFile->values.end())
+            {
+                // A pending value of another type reads as missing, like a stored one.
+                T value = defaultValue;
+                it->second.copyTo(BatchEntry(key, &value));
+                return value;
+            }
+        }
+        return innerOpen ? readInner() : defaultValue;
+    }
+
+    PendingFile &getPendingFile(const String &fileName);
+    void stage(const BatchEntry &entry);
+    void flushFile(const String &fileName);
+    void flushIfDue();
+};
+
+#endif // __H_WRITE_BACK_STORAGE_MEDIUM__
@@ -1,10 +1,17 @@
 #ifndef __H_CONFIG_HANDLER_CORE__
 #define __H_CONFIG_HANDLER_CORE__
 
+#include "CachingStorageMedium.h"
 #include "ConfigurationHandler.h"
+#include "ConfigurationFields.h"
+#include "ConfigurationSnapshot.h"
 #include "ConfigurationUtils.h"
 #include "DataStructures.h"
 #include "StorageMedium.h"
 #include "InputInterface.h"
+#include "InstrumentedStorageMedium.h"
+#include "MappedRegion.h"
+#include "MemoryStorageMedium.h"
+#include "WriteBackStorageMedium.h"
 
 #endif // __H_CONFIG_HANDLER_CORE__
@@ -0,0 +1,54 @@
+#include <stdexcept>
+#include "ByteStream.h"
+
+namespace ByteStream
+{
+    void putInteger(std::vector<uint8_t> &data, uint64_t value, const size_t size)
+    {
+        for (size_t i = 0; i < size; i++, value >>= 8)
+            data.push_back(static_cast<uint8_t>(value));
+    }
+
+    void putString(std::vector<uint8_t> &data, const String &value)
+    {
+        if (value.length() > UINT16_MAX)
+            throw std::length_error("String is too long to store!");
+        putInteger(data, value.length(), 2);
+        data.insert(data.end(), value.c_str(), value.c_str() + value.length());
+    }
+
+    uint64_t getInteger(const uint8_t *bytes, const size_t size)
+    {
+        uint64_t value = 0;
+        for (size_t i = size; i > 0; i--)
+            value = (value << 8) | bytes[i - 1];
+        return value;
+    }
+
+    uint64_t Reader::getInteger(const size_t length)
+    {
+        const uint8_t *bytes = take(length);
+        return bytes == nullptr ? 0 : ByteStream::getInteger(bytes, length);
+    }
+
+    String Reader::getString()
+    {
+        const size_t length = getInteger(2);
+        const uint8_t *bytes = take(length);
+        if (bytes == nullptr)
+            return String();
+        return String(reinterpret_cast<const char *>(bytes), static_cast<unsigned int>(length));
+    }
+
+    const uint8_t *Reader::take(const size_t length)
+    {
+        if (failed || length > size - position)
+        {
+            failed = true;
+            return nullptr;
+        }
+        const uint8_t *bytes = data + position;
+        position += length;
+        return bytes;
+    }
+}
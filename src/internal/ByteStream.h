@@ -0,0 +1,52 @@
+#ifndef __H_BYTE_STREAM__
+#define __H_BYTE_STREAM__
+#include <WString.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <vector>
+
+/**
+ * @brief Helpers for the binary formats stored in blobs: integers are little-endian, strings are a 2-byte length followed by the characters.
+ */
+namespace ByteStream
+{
+    void putInteger(std::vector<uint8_t> &data, uint64_t value, const size_t size);
+
+    /**
+     * @brief The integer of `size` bytes at `bytes`, which must all be readable (see `Reader` to read fields in order with bounds checks).
+     */
+    uint64_t getInteger(const uint8_t *bytes, const size_t size);
+
+    /**
+     * @brief Throws `std::length_error` if the string is longer than 65535 characters.
+     */
+    void putString(std::vector<uint8_t> &data, const String &value);
+
+    /**
+     * @brief Reads the fields of a blob in order, failing (and staying failed) at the end of the data.
+     */
+    class Reader
+    {
+    public:
+        Reader(const uint8_t *data, const size_t size) : data(data), size(size), position(0), failed(false) {}
+
+        bool isFailed() const { return failed; }
+        size_t getPosition() const { return position; }
+
+        uint64_t getInteger(const size_t length);
+        String getString();
+
+        /**
+         * @brief The next `length` bytes, `nullptr` if there are not enough.
+         */
+        const uint8_t *take(const size_t length);
+
+    private:
+        const uint8_t *data;
+        const size_t size;
+        size_t position;
+        bool failed;
+    };
+}
+
+#endif // __H_BYTE_STREAM__
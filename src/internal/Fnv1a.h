@@ -0,0 +1,39 @@
+#ifndef __H_FNV1A__
+#define __H_FNV1A__
+#include <WString.h>
+#include <stddef.h>
+#include <stdint.h>
+
+/**
+ * @brief The 32-bit FNV-1a hash, used for the schema hashes and fingerprints that detect changes (not for security).
+ * Start from `OFFSET_BASIS` and add the fields in order.
+ */
+namespace Fnv1a
+{
+    constexpr uint32_t OFFSET_BASIS = 2166136261u;
+    constexpr uint32_t PRIME = 16777619u;
+
+    inline void add(uint32_t &hash, const uint8_t *bytes, const size_t size)
+    {
+        for (size_t i = 0; i < size; i++)
+        {
+            hash ^= bytes[i];
+            hash *= PRIME;
+        }
+    }
+
+    inline void add(uint32_t &hash, const uint8_t byte)
+    {
+        add(hash, &byte, 1);
+    }
+
+    /**
+     * @brief Adds the characters and the terminating null, which separates the string from the next field.
+     */
+    inline void add(uint32_t &hash, const String &text)
+    {
+        add(hash, reinterpret_cast<const uint8_t *>(text.c_str()), text.length() + 1);
+    }
+}
+
+#endif // __H_FNV1A__
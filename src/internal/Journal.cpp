@@ -0,0 +1,232 @@
+#include <HardwareSerial.h>
+#include <stdexcept>
+#include <string.h>
+#include "ByteStream.h"
+#include "Journal.h"
+#include "PackedConfiguration.h"
+
+namespace
+{
+    using namespace ByteStream;
+    typedef StorageMedium::BatchEntry::Type Type;
+
+    constexpr uint8_t MAGIC[] = {'C', 'H', 'J'};
+    constexpr size_t HEADER_SIZE = sizeof(MAGIC) + 1 + 2;
+    constexpr size_t CRC_SIZE = 4;
+}
+
+const char *const Journal::FILE_NAME = "/journal";
+
+void Journal::open(const String &fileName, const FileMode fileMode)
+{
+    Record record{};
+    record.kind = RecordKind::OPEN;
+    record.fileMode = fileMode;
+    record.name = fileName;
+    records.push_back(std::move(record));
+}
+
+void Journal::write(const StorageMedium::BatchEntry &entry)
+{
+    Record record{};
+    record.kind = RecordKind::WRITE;
+    record.name = entry.getKey();
+    record.value = StagedValue(entry);
+    records.push_back(std::move(record));
+}
+
+void Journal::writeBlob(const String &fileName, const std::vector<uint8_t> &data)
+{
+    Record record{};
+    record.kind = RecordKind::BLOB;
+    record.name = fileName;
+    record.data = data;
+    records.push_back(std::move(record));
+}
+
+void Journal::remove(const String &fileName)
+{
+    Record record{};
+    record.kind = RecordKind::DELETE;
+    record.name = fileName;
+    records.push_back(std::move(record));
+}
+
+std::vector<uint8_t> Journal::encode() const
+{
+    if (records.size() > UINT16_MAX)
+        throw std::length_error("Too many writes for the journal!");
+
+    std::vector<uint8_t> data(MAGIC, MAGIC + sizeof(MAGIC));
+    data.push_back(VERSION);
+    putInteger(data, records.size(), 2);
+    for (const Record &record : records)
+    {
+        data.push_back(static_cast<uint8_t>(record.kind));
+        switch (record.kind)
+        {
+        case RecordKind::OPEN:
+            data.push_back(static_cast<uint8_t>(record.fileMode));
+            putString(data, record.name);
+            break;
+        case RecordKind::WRITE:
+            putString(data, record.name);
+            data.push_back(static_cast<uint8_t>(record.value.getType()));
+            if (record.value.getType() == Type::STRING)
+                putString(data, record.value.getText());
+            else
+                putInteger(data, record.value.getBits(), StagedValue::getSize(record.value.getType()));
+            break;
+        case RecordKind::BLOB:
+            putString(data, record.name);
+            putInteger(data, record.data.size(), 4);
+            data.insert(data.end(), record.data.begin(), record.data.end());
+            break;
+        case RecordKind::DELETE:
+            putString(data, record.name);
+            break;
+        }
+    }
+    putInteger(data, PackedConfiguration::crc32(data.data(), data.size()), CRC_SIZE);
+    return data;
+}
+
+bool Journal::decode(const std::vector<uint8_t> &data)
+{
+    records.clear();
+    if (data.size() < HEADER_SIZE + CRC_SIZE || memcmp(data.data(), MAGIC, sizeof(MAGIC)) != 0 || data[sizeof(MAGIC)] != VERSION)
+        return false;
+    // The checksum covers everything but itself, so it is verified before any record is trusted.
+    const size_t contentSize = data.size() - CRC_SIZE;
+    Reader checksum(data.data() + contentSize, CRC_SIZE);
+    if (PackedConfiguration::crc32(data.data(), contentSize) != checksum.getInteger(CRC_SIZE))
+        return false;
+
+    Reader reader(data.data(), contentSize);
+    reader.take(sizeof(MAGIC) + 1);
+    const size_t count = reader.getInteger(2);
+    std::vector<Record> decoded;
+    decoded.reserve(count);
+    for (size_t i = 0; i < count && !reader.isFailed(); i++)
+    {
+        Record record{};
+        record.kind = static_cast<RecordKind>(reader.getInteger(1));
+        switch (record.kind)
+        {
+        case RecordKind::OPEN:
+        {
+            // Reading a journal must never open a file for writing in a mode the medium does not know.
+            const uint8_t fileMode = static_cast<uint8_t>(reader.getInteger(1));
+            if (fileMode > static_cast<uint8_t>(FileMode::UPDATE))
+                return false;
+            record.fileMode = static_cast<FileMode>(fileMode);
+            record.name = reader.getString();
+            break;
+        }
+        case RecordKind::WRITE:
+        {
+            record.name = reader.getString();
+            const Type type = static_cast<Type>(reader.getInteger(1));
+            if (type > Type::STRING)
+                return false;
+            if (type == Type::STRING)
+                record.value = StagedValue(reader.getString());
+            else
+                record.value = StagedValue(type, reader.getInteger(StagedValue::getSize(type)));
+            break;
+        }
+        case RecordKind::BLOB:
+        {
+            record.name = reader.getString();
+            const size_t size = reader.getInteger(4);
+            const uint8_t *bytes = reader.take(size);
+            if (bytes != nullptr)
+                record.data.assign(bytes, bytes + size);
+            break;
+        }
+        case RecordKind::DELETE:
+            record.name = reader.getString();
+            break;
+        default:
+            return false;
+        }
+        decoded.push_back(std::move(record));
+    }
+    if (reader.isFailed() || reader.getPosition() != contentSize)
+        return false;
+    records = std::move(decoded);
+    return true;
+}
+
+void Journal::apply(StorageMedium &medium) const
+{
+    size_t i = 0;
+    while (i < records.size())
+    {
+        const Record &record = records[i++];
+        if (record.kind == RecordKind::BLOB)
+        {
+            if (!medium.writeBlob(record.name, record.data))
+            {
+                Serial.printf("Error writing blob: \"%s\"\n", record.name.c_str());
+                throw std::runtime_error("Error writing blob!");
+            }
+            continue;
+        }
+        if (record.kind == RecordKind::DELETE)
+        {
+            // Replaying after a reset may find the file already deleted.
+            medium.deleteConfig(record.name);
+            continue;
+        }
+        if (record.kind != RecordKind::OPEN)
+            continue;
+
+        // The writes that follow the open go to the file in one batch.
+        std::vector<StorageMedium::BatchEntry> entries;
+        for (; i < records.size() && records[i].kind == RecordKind::WRITE; i++)
+            entries.push_back(records[i].value.getEntry(records[i].name));
+        StorageMedium::FileHandler fileHandler = medium.createFileHandler(record.name, record.fileMode);
+        if (!fileHandler)
+        {
+            Serial.printf("Error opening file: \"%s\"\n", record.name.c_str());
+            throw std::runtime_error("Error opening file!");
+        }
+        fileHandler.writeBatch(entries);
+    }
+}
+
+bool JournalingStorageMedium::openFile(const String &fileName, const FileMode fileMode)
+{
+    if (fileMode == FileMode::READ)
+        return StorageMediumDecorator::openFile(fileName, fileMode);
+    journal.open(fileName, fileMode);
+    staging = true;
+    return true;
+}
+
+void JournalingStorageMedium::closeFile()
+{
+    if (staging)
+        staging = false;
+    else
+        StorageMediumDecorator::closeFile();
+}
+
+bool JournalingStorageMedium::writeBlobImpl(const String &fileName, const std::vector<uint8_t> &data)
+{
+    journal.writeBlob(fileName, data);
+    return true;
+}
+
+bool JournalingStorageMedium::deleteImpl(const String &fileName)
+{
+    journal.remove(fileName);
+    return true;
+}
+
+void JournalingStorageMedium::writeBatch(const BatchEntry *entries, const size_t count)
+{
+    for (size_t i = 0; i < count; i++)
+        journal.write(entries[i]);
+}
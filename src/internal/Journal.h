@@ -0,0 +1,142 @@
+#ifndef __H_JOURNAL__
+#define __H_JOURNAL__
+#include <WString.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <vector>
+#include "../StorageMedium.h"
+#include "../StorageMediumDecorator.h"
+#include "StagedValue.h"
+
+/**
+ * @brief The writes of a save, staged so they can be committed to the medium at once and replayed after a reset.
+ *
+ * The journal is stored as a single blob (see `StorageMedium::writeBlob`), whose checksum makes its write the commit point:
+ * a blob that was cut short does not decode and is discarded, a blob that decodes is replayed until it is deleted.
+ * Replaying is idempotent: files opened with `FileMode::WRITE` are cleared again before their keys are written.
+ *
+ * Layout (integers are little-endian):
+ * - Header: the magic bytes "CHJ" and the format version (1 byte).
+ * - The number of records (2 bytes).
+ * - The records, each starting with its kind (1 byte):
+ *   - open: the file mode (1 byte) and the file name,
+ *   - write: the key, the value type (1 byte, `StorageMedium::BatchEntry::Type`) and the value (1/2/4/8 bytes, or a string),
+ *   - blob: the file name, the blob's size (4 bytes) and its bytes,
+ *   - delete: the file name.
+ *   Strings are a 2-byte length followed by the characters.
+ * - A CRC-32 of everything before it (4 bytes).
+ *
+ */
+class Journal
+{
+public:
+    static constexpr uint8_t VERSION = 1;
+
+    /**
+     * @brief The name of the blob that holds the committed journal.
+     */
+    static const char *const FILE_NAME;
+
+    /**
+     * @brief Stages opening `fileName`, the writes that follow go to that file.
+     */
+    void open(const String &fileName, const FileMode fileMode);
+
+    /**
+     * @brief Stages writing the value of `entry` (copied) to the file that was last opened.
+     */
+    void write(const StorageMedium::BatchEntry &entry);
+
+    /**
+     * @brief Stages writing the blob of `fileName`.
+     */
+    void writeBlob(const String &fileName, const std::vector<uint8_t> &data);
+
+    /**
+     * @brief Stages deleting the file `fileName` (its keys, not its blob).
+     */
+    void remove(const String &fileName);
+
+    bool empty() const { return records.empty(); }
+
+    std::vector<uint8_t> encode() const;
+
+    /**
+     * @brief Replaces the staged records with the ones in `data`.
+     *
+     * @return false if `data` is not a complete journal (nothing is staged then).
+     */
+    bool decode(const std::vector<uint8_t> &data);
+
+    /**
+     * @brief Performs the staged writes on `medium`, in order.
+     * Throws `std::runtime_error` if a file cannot be opened or a blob cannot be written.
+     */
+    void apply(StorageMedium &medium) const;
+
+private:
+    enum class RecordKind : uint8_t
+    {
+        OPEN,
+        WRITE,
+        BLOB,
+        DELETE,
+    };
+
+    struct Record
+    {
+        RecordKind kind;
+        FileMode fileMode;
+        /// @brief The file name for open, blob and delete records, the key for write records.
+        String name;
+        StagedValue value;
+        std::vector<uint8_t> data;
+    };
+
+    std::vector<Record> records;
+};
+
+/**
+ * @brief A storage medium that stages the writes made through it in a `Journal` instead of performing them,
+ * reads (and files opened for reading) go to the inner medium.
+ *
+ */
+class JournalingStorageMedium : public StorageMediumDecorator
+{
+public:
+    JournalingStorageMedium(StorageMedium &inner, Journal &journal) : StorageMediumDecorator(inner), journal(journal), staging(false) {}
+
+protected:
+    bool openFile(const String &fileName, const FileMode fileMode) override;
+    void closeFile() override;
+
+    bool writeBlobImpl(const String &fileName, const std::vector<uint8_t> &data) override;
+
+    bool deleteImpl(const String &fileName) override;
+    // Only files that exist on the inner medium are staged for deletion.
+    bool handlesMissingFilesImpl() override { return false; }
+
+#pragma region Write functions
+    void writeChar(const String &key, const int8_t value) override { journal.write(StorageMedium::BatchEntry(key, &value)); }
+    void writeUChar(const String &key, const uint8_t value) override { journal.write(StorageMedium::BatchEntry(key, &value)); }
+    void writeShort(const String &key, const int16_t value) override { journal.write(StorageMedium::BatchEntry(key, &value)); }
+    void writeUShort(const String &key, const uint16_t value) override { journal.write(StorageMedium::BatchEntry(key, &value)); }
+    void writeInt(const String &key, const int32_t value) override { journal.write(StorageMedium::BatchEntry(key, &value)); }
+    void writeUInt(const String &key, const uint32_t value) override { journal.write(StorageMedium::BatchEntry(key, &value)); }
+    void writeLong(const String &key, const int64_t value) override { journal.write(StorageMedium::BatchEntry(key, &value)); }
+    void writeULong(const String &key, const uint64_t value) override { journal.write(StorageMedium::BatchEntry(key, &value)); }
+    void writeFloat(const String &key, const float value) override { journal.write(StorageMedium::BatchEntry(key, &value)); }
+    void writeDouble(const String &key, const double value) override { journal.write(StorageMedium::BatchEntry(key, &value)); }
+    void writeBool(const String &key, const bool value) override { journal.write(StorageMedium::BatchEntry(key, &value)); }
+    void writeString(const String &key, const String value) override { journal.write(StorageMedium::BatchEntry(key, &value)); }
+#pragma endregion
+
+    void writeBatch(const BatchEntry *entries, const size_t count) override;
+
+private:
+    Journal &journal;
+    /// @brief Whether the open file is staged in the journal (opened for writing) rather than opened on the inner medium.
+    bool staging;
+};
+
+#endif // __H_JOURNAL__
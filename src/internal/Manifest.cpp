@@ -0,0 +1,155 @@
+#include <stdexcept>
+#include <string.h>
+#include "ByteStream.h"
+#include "Fnv1a.h"
+#include "Manifest.h"
+#include "PackedConfiguration.h"
+#include "StagedValue.h"
+
+namespace
+{
+    using namespace ByteStream;
+
+    constexpr uint8_t MAGIC[] = {'C', 'H', 'M'};
+    constexpr size_t HEADER_SIZE = sizeof(MAGIC) + 1 + 2;
+    constexpr size_t CRC_SIZE = 4;
+
+    /**
+     * @brief Reads a flag, which must be `0` or `1`.
+     */
+    bool getFlag(Reader &reader, bool &valid)
+    {
+        const uint64_t flag = reader.getInteger(1);
+        valid = valid && flag <= 1;
+        return flag != 0;
+    }
+}
+
+const char *const Manifest::FILE_NAME = "/manifest";
+
+uint32_t Manifest::hashSchema(const std::vector<ParameterInfo> &parameters)
+{
+    uint32_t hash = Fnv1a::OFFSET_BASIS;
+    for (const ParameterInfo &parameter : parameters)
+    {
+        Fnv1a::add(hash, parameter.name);
+        Fnv1a::add(hash, static_cast<uint8_t>(parameter.type));
+        parameter.isValid.addToHash(hash);
+    }
+    return hash;
+}
+
+Manifest::Entry Manifest::makeEntry(const std::vector<ParameterInfo> &parameters, const bool present)
+{
+    return {present, present, hashSchema(parameters), 0, 0};
+}
+
+const Manifest::Entry *Manifest::find(const String &fileName) const
+{
+    const auto &it = entries.find(fileName);
+    return it == entries.end() ? nullptr : &it->second;
+}
+
+bool Manifest::set(const String &fileName, const Entry &entry)
+{
+    const auto &it = entries.find(fileName);
+    if (it != entries.end() && it->second == entry)
+        return false;
+    entries[fileName] = entry;
+    return true;
+}
+
+std::vector<uint8_t> Manifest::encode() const
+{
+    if (entries.size() > UINT16_MAX)
+        throw std::length_error("Too many configurations for the manifest!");
+
+    std::vector<uint8_t> data(MAGIC, MAGIC + sizeof(MAGIC));
+    data.push_back(VERSION);
+    putInteger(data, entries.size(), 2);
+    for (const auto &entry : entries)
+    {
+        putString(data, entry.first);
+        data.push_back(entry.second.present ? 1 : 0);
+        data.push_back(entry.second.complete ? 1 : 0);
+        putInteger(data, entry.second.schemaVersion, 4);
+        putInteger(data, entry.second.contentHash, 4);
+        putInteger(data, entry.second.validatedSchema, 4);
+    }
+    putInteger(data, PackedConfiguration::crc32(data.data(), data.size()), CRC_SIZE);
+    return data;
+}
+
+bool Manifest::decode(const std::vector<uint8_t> &data)
+{
+    entries.clear();
+    if (data.size() < HEADER_SIZE + CRC_SIZE || memcmp(data.data(), MAGIC, sizeof(MAGIC)) != 0 || data[sizeof(MAGIC)] != VERSION)
+        return false;
+    const size_t contentSize = data.size() - CRC_SIZE;
+    Reader checksum(data.data() + contentSize, CRC_SIZE);
+    if (PackedConfiguration::crc32(data.data(), contentSize) != checksum.getInteger(CRC_SIZE))
+        return false;
+
+    Reader reader(data.data(), contentSize);
+    reader.take(sizeof(MAGIC) + 1);
+    const size_t count = reader.getInteger(2);
+    std::map<String, Entry> decoded;
+    // Flags other than 0 and 1 were not written by this version.
+    bool flagsValid = true;
+    for (size_t i = 0; i < count && !reader.isFailed(); i++)
+    {
+        const String fileName = reader.getString();
+        Entry entry{};
+        entry.present = getFlag(reader, flagsValid);
+        entry.complete = getFlag(reader, flagsValid);
+        entry.schemaVersion = reader.getInteger(4);
+        entry.contentHash = reader.getInteger(4);
+        entry.validatedSchema = reader.getInteger(4);
+        decoded[fileName] = entry;
+    }
+    if (reader.isFailed() || !flagsValid || reader.getPosition() != contentSize)
+        return false;
+    entries = std::move(decoded);
+    return true;
+}
+
+void Fingerprint::add(const StorageMedium::BatchEntry &entry)
+{
+    uint32_t keyHash = Fnv1a::OFFSET_BASIS;
+    Fnv1a::add(keyHash, entry.getKey());
+    const StagedValue value(entry);
+    Fnv1a::add(keyHash, static_cast<uint8_t>(value.getType()));
+    if (value.getType() == StagedValue::Type::STRING)
+        Fnv1a::add(keyHash, value.getText());
+    else
+    {
+        uint8_t bits[8];
+        uint64_t remaining = value.getBits();
+        for (size_t i = 0; i < sizeof(bits); i++, remaining >>= 8)
+            bits[i] = static_cast<uint8_t>(remaining);
+        Fnv1a::add(keyHash, bits, sizeof(bits));
+    }
+    hash += keyHash;
+}
+
+bool FingerprintingStorageMedium::openFile(const String &fileName, const FileMode fileMode)
+{
+    if (fileMode == FileMode::READ)
+        return StorageMediumDecorator::openFile(fileName, fileMode);
+    writing = true;
+    return true;
+}
+
+void FingerprintingStorageMedium::closeFile()
+{
+    if (writing)
+        writing = false;
+    else
+        StorageMediumDecorator::closeFile();
+}
+
+void FingerprintingStorageMedium::writeBatch(const BatchEntry *entries, const size_t count)
+{
+    for (size_t i = 0; i < count; i++)
+        fingerprint.add(entries[i]);
+}
@@ -0,0 +1,206 @@
+#ifndef __H_MANIFEST__
+#define __H_MANIFEST__
+#include <WString.h>
+#include <map>
+#include <stddef.h>
+#include <stdint.h>
+#include <vector>
+#include "../DataStructures.h"
+#include "../StorageMedium.h"
+#include "../StorageMediumDecorator.h"
+#include "Fnv1a.h"
+#include "StagedValue.h"
+
+/**
+ * @brief An index of the stored configurations, kept in a single blob so their existence and completeness can be checked with one read.
+ *
+ * Each entry records, for a configuration file: whether it is present, whether it holds all the parameters' keys, and the schema version it was checked with.
+ * It also holds the file's fingerprint: a hash of its values (see `Fingerprint`), and the schema version they were validated against,
+ * so a boot check can skip validating them again.
+ * An entry is only trusted while the schema version matches the configuration's current parameters, otherwise the file must be checked.
+ *
+ * Layout (integers are little-endian):
+ * - Header: the magic bytes "CHM" and the format version (1 byte).
+ * - The number of entries (2 bytes).
+ * - The entries: the file name (a 2-byte length followed by the characters), presence and completeness (1 byte each), the schema version,
+ *   the content hash and the validated schema version (4 bytes each).
+ * - A CRC-32 of everything before it (4 bytes).
+ *
+ */
+class Manifest
+{
+public:
+    static constexpr uint8_t VERSION = 3;
+
+    /**
+     * @brief The name of the blob that holds the manifest.
+     */
+    static const char *const FILE_NAME;
+
+    struct Entry
+    {
+        bool present;
+        /// @brief Whether the file holds the keys of all the parameters of the schema version.
+        bool complete;
+        /// @brief The hash of the parameters when the file was saved (see `hashSchema`).
+        uint32_t schemaVersion;
+        /// @brief The hash of the values in the file (see `Fingerprint`), `0` if unknown.
+        uint32_t contentHash;
+        /// @brief The schema version the values were validated against, `0` if they were not validated.
+        uint32_t validatedSchema;
+
+        bool operator==(const Entry &other) const
+        {
+            return present == other.present && complete == other.complete && schemaVersion == other.schemaVersion &&
+                   contentHash == other.contentHash && validatedSchema == other.validatedSchema;
+        }
+        bool operator!=(const Entry &other) const { return !(*this == other); }
+    };
+
+    /**
+     * @brief FNV-1a over the parameters' names, types and validators (see `Validator::addToHash`), in order.
+     */
+    static uint32_t hashSchema(const std::vector<ParameterInfo> &parameters);
+
+    /**
+     * @brief The entry of a configuration saved with all of `parameters` (present and complete), or of a missing configuration, without a fingerprint.
+     */
+    static Entry makeEntry(const std::vector<ParameterInfo> &parameters, const bool present);
+
+    /**
+     * @return The entry of `fileName`, `nullptr` if the manifest has none.
+     */
+    const Entry *find(const String &fileName) const;
+
+    /**
+     * @return Whether the manifest changed.
+     */
+    bool set(const String &fileName, const Entry &entry);
+
+    std::vector<uint8_t> encode() const;
+
+    /**
+     * @brief Replaces the entries with the ones in `data`.
+     *
+     * @return false if `data` is not a valid manifest (the manifest is left empty then).
+     */
+    bool decode(const std::vector<uint8_t> &data);
+
+private:
+    std::map<String, Entry> entries;
+};
+
+/**
+ * @brief The hash of a configuration's stored values: of each key with its type and value, as they are written by a save and read back by a load.
+ * Floats are hashed as stored, so "1.50" and "1.5" give the same fingerprint.
+ * The hashes of the keys (FNV-1a) are added up, so the order of the reads or writes does not matter.
+ *
+ */
+class Fingerprint
+{
+public:
+    void add(const StorageMedium::BatchEntry &entry);
+
+    template <typename Entries>
+    void addAll(const Entries &entries)
+    {
+        for (const StorageMedium::BatchEntry &entry : entries)
+            add(entry);
+    }
+
+    uint32_t get() const { return hash; }
+
+private:
+    // Not 0, which the manifest uses for an unknown hash.
+    uint32_t hash = Fnv1a::OFFSET_BASIS;
+};
+
+/**
+ * @brief Adds the values read from the inner medium to a fingerprint, only the keys that are stored.
+ * Files opened for writing are not written to the inner medium: the values written to them are only added to the fingerprint.
+ *
+ */
+class FingerprintingStorageMedium : public StorageMediumDecorator
+{
+public:
+    FingerprintingStorageMedium(StorageMedium &inner, Fingerprint &fingerprint) : StorageMediumDecorator(inner), fingerprint(fingerprint) {}
+
+protected:
+    bool openFile(const String &fileName, const FileMode fileMode) override;
+    void closeFile() override;
+
+#pragma region Read and Write functions
+    int8_t readChar(const String &key, const int8_t defaultValue) override { return readFound(key, defaultValue, [&](const int8_t fallback) { return StorageMediumDecorator::readChar(key, fallback); }); }
+    uint8_t readUChar(const String &key, const uint8_t defaultValue) override { return readFound(key, defaultValue, [&](const uint8_t fallback) { return StorageMediumDecorator::readUChar(key, fallback); }); }
+    int16_t readShort(const String &key, const int16_t defaultValue) override { return readFound(key, defaultValue, [&](const int16_t fallback) { return StorageMediumDecorator::readShort(key, fallback); }); }
+    uint16_t readUShort(const String &key, const uint16_t defaultValue) override { return readFound(key, defaultValue, [&](const uint16_t fallback) { return StorageMediumDecorator::readUShort(key, fallback); }); }
+    int32_t readInt(const String &key, const int32_t defaultValue) override { return readFound(key, defaultValue, [&](const int32_t fallback) { return StorageMediumDecorator::readInt(key, fallback); }); }
+    uint32_t readUInt(const String &key, const uint32_t defaultValue) override { return readFound(key, defaultValue, [&](const uint32_t fallback) { return StorageMediumDecorator::readUInt(key, fallback); }); }
+    int64_t readLong(const String &key, const int64_t defaultValue) override { return readFound(key, defaultValue, [&](const int64_t fallback) { return StorageMediumDecorator::readLong(key, fallback); }); }
+    uint64_t readULong(const String &key, const uint64_t defaultValue) override { return readFound(key, defaultValue, [&](const uint64_t fallback) { return StorageMediumDecorator::readULong(key, fallback); }); }
+    float readFloat(const String &key, const float defaultValue) override { return readFound(key, defaultValue, [&](const float fallback) { return StorageMediumDecorator::readFloat(key, fallback); }); }
+    double readDouble(const String &key, const double defaultValue) override { return readFound(key, defaultValue, [&](const double fallback) { return StorageMediumDecorator::readDouble(key, fallback); }); }
+    bool readBool(const String &key, const bool defaultValue) override { return readFound(key, defaultValue, [&](const bool fallback) { return StorageMediumDecorator::readBool(key, fallback); }); }
+    String readString(const String &key, const String defaultValue) override { return readFound(key, defaultValue, [&](const String fallback) { return StorageMediumDecorator::readString(key, fallback); }); }
+
+    void writeChar(const String &key, const int8_t value) override { added(key, value); }
+    void writeUChar(const String &key, const uint8_t value) override { added(key, value); }
+    void writeShort(const String &key, const int16_t value) override { added(key, value); }
+    void writeUShort(const String &key, const uint16_t value) override { added(key, value); }
+    void writeInt(const String &key, const int32_t value) override { added(key, value); }
+    void writeUInt(const String &key, const uint32_t value) override { added(key, value); }
+    void writeLong(const String &key, const int64_t value) override { added(key, value); }
+    void writeULong(const String &key, const uint64_t value) override { added(key, value); }
+    void writeFloat(const String &key, const float value) override { added(key, value); }
+    void writeDouble(const String &key, const double value) override { added(key, value); }
+    void writeBool(const String &key, const bool value) override { added(key, value); }
+    void writeString(const String &key, const String value) override { added(key, value); }
+#pragma endregion
+
+    // Key by key, through the functions above.
+    void readBatch(const BatchEntry *entries, const size_t count) override { StorageMedium::readBatch(entries, count); }
+    void writeBatch(const BatchEntry *entries, const size_t count) override;
+
+private:
+    Fingerprint &fingerprint;
+    /// @brief Whether the open file was opened for writing, and is not open in the inner medium.
+    bool writing = false;
+
+    template <typename T>
+    T added(const String &key, const T value)
+    {
+        fingerprint.add(BatchEntry(key, &value));
+        return value;
+    }
+
+    /**
+     * @brief Reads a key with `read`, adding it to the fingerprint only if it is stored, so a missing key changes the fingerprint.
+     * A missing key reads as `defaultValue`: a value equal to it is read again with another default to tell them apart.
+     */
+    template <typename T, typename Read>
+    T readFound(const String &key, const T defaultValue, Read &&read)
+    {
+        const T value = read(defaultValue);
+        const BatchEntry entry(key, &value);
+        if (StagedValue(entry) != StagedValue(BatchEntry(key, &defaultValue)))
+            fingerprint.add(entry);
+        else
+        {
+            const T otherDefault = getOtherValue(defaultValue);
+            const T probed = read(otherDefault);
+            if (StagedValue(BatchEntry(key, &probed)) != StagedValue(BatchEntry(key, &otherDefault)))
+                fingerprint.add(entry);
+        }
+        return value;
+    }
+
+    /**
+     * @return A value whose bits differ from those of `value`.
+     */
+    template <typename T>
+    static T getOtherValue(const T value) { return value == T(0) ? T(1) : T(0); }
+    static bool getOtherValue(const bool value) { return !value; }
+    static String getOtherValue(const String &value) { return value + " "; }
+};
+
+#endif // __H_MANIFEST__
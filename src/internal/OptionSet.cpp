@@ -0,0 +1,60 @@
+#include <Arduino.h>
+#include <algorithm>
+#include <stdexcept>
+#include "OptionSet.h"
+
+const std::vector<String> &OptionSet::get()
+{
+    ensureLoaded();
+    return options;
+}
+
+bool OptionSet::contains(const String &value)
+{
+    return indexOf(value) >= 0;
+}
+
+int OptionSet::indexOf(const String &value)
+{
+    ensureLoaded();
+    return find(value);
+}
+
+int OptionSet::indexOfCached(const String &value) const
+{
+    return isStale() ? -1 : find(value);
+}
+
+int OptionSet::find(const String &value) const
+{
+    const auto it = std::lower_bound(sorted.begin(), sorted.end(), value, [this](const uint16_t position, const String &target)
+                                     { return options[position] < target; });
+    return it != sorted.end() && options[*it].equals(value) ? *it : -1;
+}
+
+void OptionSet::refresh()
+{
+    options = provider();
+    if (options.size() > UINT16_MAX)
+        throw std::length_error("Too many options!");
+    sorted.resize(options.size());
+    for (size_t i = 0; i < options.size(); i++)
+        sorted[i] = static_cast<uint16_t>(i);
+    std::sort(sorted.begin(), sorted.end(), [this](const uint16_t left, const uint16_t right)
+              { return options[left] < options[right]; });
+    loaded = true;
+    loadedAt = millis();
+    revision++;
+}
+
+bool OptionSet::isStale() const
+{
+    // Unsigned subtraction keeps working when millis() wraps around.
+    return !loaded || (refreshIntervalMs != 0 && millis() - loadedAt >= refreshIntervalMs);
+}
+
+void OptionSet::ensureLoaded()
+{
+    if (isStale())
+        refresh();
+}
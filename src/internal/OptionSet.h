@@ -0,0 +1,94 @@
+#ifndef __H_OPTION_SET__
+#define __H_OPTION_SET__
+#include <WString.h>
+#include <functional>
+#include <stdint.h>
+#include <vector>
+
+/**
+ * @brief A cache of the valid options of a parameter of type `ParameterType::TYPE_OPTIONSET`.
+ * The options are fetched from the provider the first time they are needed, and again only when the cache is refreshed,
+ * either explicitly (`refresh`) or because it is older than the refresh interval.
+ *
+ * A `ParametersManager` owns one per option parameter, so the options live as long as the input session and expensive providers (e.g. a Wi-Fi scan)
+ * run once per session instead of once per validation. Membership checks are binary searches instead of linear scans.
+ *
+ */
+class OptionSet
+{
+public:
+    typedef std::function<std::vector<String>()> Provider;
+
+    /**
+     * @param provider Returns all the valid options.
+     * @param refreshIntervalMs The time after which the options are fetched again, or `0` to keep them until `refresh` is called.
+     */
+    OptionSet(const Provider &provider, const unsigned long refreshIntervalMs = 0)
+        : provider(provider), refreshIntervalMs(refreshIntervalMs), options(), sorted(), loaded(false), loadedAt(0), revision(0) {}
+
+    /**
+     * @brief The options, in the order returned by the provider (fetched if needed).
+     * The reference is valid until the next refresh.
+     */
+    const std::vector<String> &get();
+
+    /**
+     * @brief The options as they were last fetched, without fetching them (empty if they never were).
+     */
+    const std::vector<String> &getCached() const { return options; }
+
+    /**
+     * @brief Whether `value` is one of the options (fetched if needed).
+     */
+    bool contains(const String &value);
+
+    /**
+     * @brief The position of `value` in the options (fetched if needed), or `-1` if it is not one of them.
+     */
+    int indexOf(const String &value);
+
+    /**
+     * @brief The position of `value` in the options, without fetching them: `-1` if it is not one of them, or if the options are stale (see `isStale`).
+     */
+    int indexOfCached(const String &value) const;
+
+    /**
+     * @brief Fetches the options from the provider now.
+     */
+    void refresh();
+
+    /**
+     * @brief Whether the options were fetched (they may be stale).
+     */
+    bool isLoaded() const { return loaded; }
+
+    /**
+     * @brief Whether the options will be fetched the next time they are needed (never fetched, dropped, or older than the refresh interval).
+     */
+    bool isStale() const;
+
+    /**
+     * @brief Incremented every time the options are fetched, so positions found in older options can be told apart.
+     */
+    uint32_t getRevision() const { return revision; }
+
+    /**
+     * @brief Drops the options, they are fetched again the next time they are needed.
+     */
+    void invalidate() { loaded = false; }
+
+private:
+    const Provider provider;
+    const unsigned long refreshIntervalMs;
+    std::vector<String> options;
+    /// @brief Positions in `options`, sorted by value for membership checks.
+    std::vector<uint16_t> sorted;
+    bool loaded;
+    unsigned long loadedAt;
+    uint32_t revision;
+
+    void ensureLoaded();
+    int find(const String &value) const;
+};
+
+#endif // __H_OPTION_SET__
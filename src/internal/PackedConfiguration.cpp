@@ -0,0 +1,152 @@
+#include <stdexcept>
+#include <string.h>
+#include "ByteStream.h"
+#include "Fnv1a.h"
+#include "PackedConfiguration.h"
+#include "StagedValue.h"
+
+namespace
+{
+    using namespace ByteStream;
+    typedef StorageMedium::BatchEntry::Type Type;
+
+    constexpr uint8_t MAGIC[] = {'C', 'H', 'P'};
+    constexpr size_t HEADER_SIZE = sizeof(MAGIC) + 1 + 4 + 2;
+    constexpr size_t CRC_SIZE = 4;
+
+    /**
+     * @brief The size of a field's value in the blob: the value itself, or the 2-byte length of a string. `0` for an unknown type.
+     */
+    size_t getFixedSize(const Type type)
+    {
+        return type == Type::STRING ? 2 : StagedValue::getSize(type);
+    }
+}
+
+namespace PackedConfiguration
+{
+    uint32_t schemaHash(const StorageMedium::BatchEntry *entries, const size_t count)
+    {
+        // FNV-1a over the keys and types; the terminating null separates the key from the type.
+        uint32_t hash = Fnv1a::OFFSET_BASIS;
+        for (size_t i = 0; i < count; i++)
+        {
+            Fnv1a::add(hash, entries[i].getKey());
+            Fnv1a::add(hash, static_cast<uint8_t>(entries[i].getType()));
+        }
+        return hash;
+    }
+
+    std::vector<uint8_t> encode(const StorageMedium::BatchEntry *entries, const size_t count)
+    {
+        if (count > UINT16_MAX)
+            throw std::length_error("Too many fields to pack!");
+
+        size_t size = HEADER_SIZE + CRC_SIZE;
+        for (size_t i = 0; i < count; i++)
+            size += 1 + getFixedSize(entries[i].getType()) + (entries[i].getType() == Type::STRING ? entries[i].getValueSize() : 0);
+
+        std::vector<uint8_t> blob(MAGIC, MAGIC + sizeof(MAGIC));
+        blob.reserve(size);
+        blob.push_back(VERSION);
+        putInteger(blob, schemaHash(entries, count), 4);
+        putInteger(blob, count, 2);
+        for (size_t i = 0; i < count; i++)
+        {
+            const StorageMedium::BatchEntry &entry = entries[i];
+            blob.push_back(static_cast<uint8_t>(entry.getType()));
+            if (entry.getType() == Type::STRING)
+                putString(blob, entry.getValue<String>());
+            else
+                putInteger(blob, StagedValue(entry).getBits(), getFixedSize(entry.getType()));
+        }
+        putInteger(blob, crc32(blob.data(), blob.size()), CRC_SIZE);
+        return blob;
+    }
+
+    DecodeResult index(const uint8_t *data, const size_t size, const StorageMedium::BatchEntry *entries, const size_t count,
+                       std::vector<uint32_t> &offsets, size_t &blobSize)
+    {
+        if (size < HEADER_SIZE + CRC_SIZE || memcmp(data, MAGIC, sizeof(MAGIC)) != 0 || data[sizeof(MAGIC)] != VERSION)
+            return DecodeResult::CORRUPT;
+
+        // Walk the fields to find where the blob ends, the checksum is verified before anything is trusted.
+        std::vector<uint32_t> positions;
+        positions.reserve(count);
+        const size_t fieldsCount = getInteger(data + sizeof(MAGIC) + 5, 2);
+        size_t position = HEADER_SIZE;
+        for (size_t i = 0; i < fieldsCount; i++)
+        {
+            if (position + 1 > size - CRC_SIZE)
+                return DecodeResult::CORRUPT;
+            const Type type = static_cast<Type>(data[position]);
+            const size_t fixedSize = getFixedSize(type);
+            if (fixedSize == 0 || position + 1 + fixedSize > size - CRC_SIZE)
+                return DecodeResult::CORRUPT;
+            if (i < count)
+                positions.push_back(static_cast<uint32_t>(position));
+            position += 1 + fixedSize;
+            if (type == Type::STRING)
+                position += getInteger(data + position - fixedSize, fixedSize);
+        }
+        if (position > size - CRC_SIZE || crc32(data, position) != getInteger(data + position, CRC_SIZE))
+            return DecodeResult::CORRUPT;
+
+        if (getInteger(data + sizeof(MAGIC) + 1, 4) != schemaHash(entries, count) || fieldsCount != count)
+            return DecodeResult::STALE_SCHEMA;
+        for (size_t i = 0; i < count; i++)
+        {
+            if (data[positions[i]] != static_cast<uint8_t>(entries[i].getType()))
+                return DecodeResult::CORRUPT;
+        }
+        offsets = std::move(positions);
+        blobSize = position + CRC_SIZE;
+        return DecodeResult::OK;
+    }
+
+    DecodeResult decode(const std::vector<uint8_t> &blob, const StorageMedium::BatchEntry *entries, const size_t count)
+    {
+        std::vector<uint32_t> offsets;
+        size_t blobSize;
+        const DecodeResult result = index(blob.data(), blob.size(), entries, count, offsets, blobSize);
+        if (result != DecodeResult::OK)
+            return result;
+        if (blobSize != blob.size())
+            return DecodeResult::CORRUPT;
+        for (size_t i = 0; i < count; i++)
+            readField(blob.data(), offsets[i], entries[i]);
+        return DecodeResult::OK;
+    }
+
+    void readField(const uint8_t *data, const uint32_t offset, const StorageMedium::BatchEntry &entry)
+    {
+        if (entry.getType() == Type::STRING)
+        {
+            const std::string_view value = readString(data, offset);
+            entry.getValue<String>() = String(value.data(), static_cast<unsigned int>(value.size()));
+        }
+        else
+            StagedValue(entry.getType(), getInteger(data + offset + 1, getFixedSize(entry.getType()))).copyTo(entry);
+    }
+
+    std::string_view readString(const uint8_t *data, const uint32_t offset)
+    {
+        const size_t length = getInteger(data + offset + 1, 2);
+        return std::string_view(reinterpret_cast<const char *>(data + offset + 3), length);
+    }
+
+    uint32_t crc32(const uint8_t *data, const size_t size, uint32_t crc)
+    {
+        // Half-byte table: 64 bytes of constants instead of 1KB, fast enough for configuration-sized data.
+        static const uint32_t table[16] = {
+            0x00000000, 0x1DB71064, 0x3B6E20C8, 0x26D930AC, 0x76DC4190, 0x6B6B51F4, 0x4DB26158, 0x5005713C,
+            0xEDB88320, 0xF00F9344, 0xD6D6A3E8, 0xCB61B38C, 0x9B64C2B0, 0x86D3D2D4, 0xA00AE278, 0xBDBDF21C};
+        crc = ~crc;
+        for (size_t i = 0; i < size; i++)
+        {
+            crc = table[(crc ^ data[i]) & 0x0F] ^ (crc >> 4);
+            crc = table[(crc ^ (data[i] >> 4)) & 0x0F] ^ (crc >> 4);
+        }
+        return ~crc;
+    }
+}
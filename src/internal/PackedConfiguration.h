@@ -0,0 +1,83 @@
+#ifndef __H_PACKED_CONFIGURATION__
+#define __H_PACKED_CONFIGURATION__
+#include <WString.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <string_view>
+#include <vector>
+#include "../StorageMedium.h"
+
+/**
+ * @brief Encodes a whole configuration as one binary blob, so it can be stored and loaded in a single medium access.
+ *
+ * Layout (integers are little-endian):
+ * - Header: the magic bytes "CHP" and the format version (1 byte).
+ * - The schema hash (4 bytes), computed from the keys and value types of the fields, in order.
+ * - The number of fields (2 bytes).
+ * - The fields, in order: the value type (1 byte, `StorageMedium::BatchEntry::Type`) followed by the value
+ *   (1/2/4/8 bytes, strings are a 2-byte length followed by the characters).
+ * - A CRC-32 of everything before it (4 bytes).
+ *
+ * The fields are described by `StorageMedium::BatchEntry`s, which point at the variables to encode or to decode into.
+ *
+ */
+namespace PackedConfiguration
+{
+    static constexpr uint8_t VERSION = 1;
+
+    enum class DecodeResult : uint8_t
+    {
+        OK,
+        /// @brief Not a packed configuration, a different format version, or the checksum does not match.
+        CORRUPT,
+        /// @brief A valid blob written with a different set of fields (e.g. by an older firmware).
+        STALE_SCHEMA,
+    };
+
+    /**
+     * @brief A hash of the keys and value types of `entries`, in order, that changes whenever the layout of the blob changes.
+     */
+    uint32_t schemaHash(const StorageMedium::BatchEntry *entries, const size_t count);
+
+    /**
+     * @brief Encodes the values of `entries` into a blob.
+     *
+     * @throws std::length_error If there are more than 65535 entries, or a string is longer than 65535 characters.
+     */
+    std::vector<uint8_t> encode(const StorageMedium::BatchEntry *entries, const size_t count);
+
+    /**
+     * @brief Decodes `blob` into the variables of `entries`.
+     * The variables are changed only if the result is `DecodeResult::OK`.
+     */
+    DecodeResult decode(const std::vector<uint8_t> &blob, const StorageMedium::BatchEntry *entries, const size_t count);
+
+    /**
+     * @brief Checks a blob in place (header, checksum and schema) and finds each field in it, without copying anything.
+     * The blob may be followed by other data (e.g. the rest of a flash partition), its own size is returned in `blobSize`.
+     *
+     * @param data The start of the blob.
+     * @param size The number of bytes available at `data`.
+     * @param offsets Receives the offset of each field in the blob (the position of its type byte).
+     * @param blobSize Receives the size of the blob.
+     */
+    DecodeResult index(const uint8_t *data, const size_t size, const StorageMedium::BatchEntry *entries, const size_t count,
+                       std::vector<uint32_t> &offsets, size_t &blobSize);
+
+    /**
+     * @brief Decodes the field at `offset` (found by `index`) into the variable of `entry`, which must be the field's entry.
+     */
+    void readField(const uint8_t *data, const uint32_t offset, const StorageMedium::BatchEntry &entry);
+
+    /**
+     * @brief The characters of the string field at `offset` (found by `index`), in place.
+     */
+    std::string_view readString(const uint8_t *data, const uint32_t offset);
+
+    /**
+     * @brief The standard CRC-32 (as used by zlib and Ethernet) of `size` bytes, continuing from `crc` (`0` to start).
+     */
+    uint32_t crc32(const uint8_t *data, const size_t size, const uint32_t crc = 0);
+}
+
+#endif // __H_PACKED_CONFIGURATION__
@@ -1,68 +1,297 @@
+#include <stdexcept>
 #include "ParametersManager.h"
 
-void ParametersManager::addParameter(const String &category, const ParameterInfo &parameter, const String &currentValue, std::function<std::vector<String>(const String &)> getOptions)
+ParametersManager::ParameterHandle ParametersManager::addParameter(const String &category, const ParameterInfo &parameter, const String &currentValue, std::function<std::vector<String>(const String &)> getOptions)
 {
-    parameters[category].emplace(parameter.name, Parameter(parameter, currentValue, getOptions));
+    const size_t categoryIndex = findCategory(category);
+    if (categoryIndex == categories.size())
+    {
+        if (categories.size() > UINT16_MAX)
+            throw std::length_error("Too many categories!");
+        categories.push_back({category, {}, {}, 0});
+    }
+    Category *categoryEntry = &categories[categoryIndex];
+
+    // Adding an existing parameter keeps the existing one.
+    const size_t position = lowerBound(*categoryEntry, parameter.name);
+    if (position < categoryEntry->sortedByName.size())
+    {
+        const ParameterHandle existing = categoryEntry->parameters[categoryEntry->sortedByName[position]];
+        if (parameters[existing].param.name.equals(parameter.name))
+            return existing;
+    }
+
+    if (parameters.size() > UINT16_MAX)
+        throw std::length_error("Too many parameters!");
+    const ParameterHandle handle = static_cast<ParameterHandle>(parameters.size());
+    parameters.emplace_back(parameter, currentValue, static_cast<uint16_t>(categoryIndex), getOptions);
+    categoryEntry->sortedByName.insert(categoryEntry->sortedByName.begin() + position, static_cast<uint16_t>(categoryEntry->parameters.size()));
+    categoryEntry->parameters.push_back(handle);
+    return handle;
 }
 
-std::vector<String> ParametersManager::getParameterOptions(const String &category, const String &parameterName, bool refresh)
+ParametersManager::ParameterHandle ParametersManager::getHandle(const String &category, const String &parameterName) const
 {
-    Parameter &param = parameters.at(category).at(parameterName);
-    return param.getOptions(refresh);
+    const size_t categoryIndex = findCategory(category);
+    if (categoryIndex < categories.size())
+    {
+        const Category &categoryEntry = categories[categoryIndex];
+        const size_t position = findInCategory(categoryEntry, parameterName);
+        if (position < categoryEntry.parameters.size())
+            return categoryEntry.parameters[position];
+    }
+    throw std::out_of_range("No such parameter!");
+}
+
+const std::vector<ParametersManager::ParameterHandle> &ParametersManager::getCategoryParameters(const String &category) const
+{
+    const size_t categoryIndex = findCategory(category);
+    if (categoryIndex == categories.size())
+        throw std::out_of_range("No such category!");
+    return categories[categoryIndex].parameters;
+}
+
+const std::vector<String> &ParametersManager::getParameterOptions(const String &category, const String &parameterName, bool refresh)
+{
+    return getParameterOptions(getHandle(category, parameterName), refresh);
+}
+
+const std::vector<String> &ParametersManager::getParameterOptions(const ParameterHandle handle, bool refresh)
+{
+    return parameters.at(handle).getOptions(refresh);
 }
 
 std::map<String, String> ParametersManager::getParametersValues(const String &category) const
 {
-    std::map<String, String> values;
-    const std::map<String, Parameter> &params = parameters.at(category);
-    for (const auto &[_, parameter] : params)
+    return getParametersView(category).toMap();
+}
+
+ParameterValuesView ParametersManager::getParametersView(const String &category) const
+{
+    const size_t categoryIndex = findCategory(category);
+    if (categoryIndex == categories.size())
+        throw std::out_of_range("No such category!");
+    return ParameterValuesView(*this, categories[categoryIndex]);
+}
+
+const ParameterInfo &ParametersManager::getParameterInfo(const ParameterHandle handle) const
+{
+    return parameters.at(handle).param;
+}
+
+const String &ParametersManager::getOriginalValue(const String &category, const String &parameterName) const
+{
+    return getOriginalValue(getHandle(category, parameterName));
+}
+
+const String &ParametersManager::getOriginalValue(const ParameterHandle handle) const
+{
+    return parameters.at(handle).value;
+}
+
+const String &ParametersManager::getValue(const ParameterHandle handle) const
+{
+    const Parameter &parameter = parameters.at(handle);
+    return parameter.newValue.has_value() ? parameter.newValue.value() : parameter.value;
+}
+
+const TypedValue &ParametersManager::getTypedValue(const ParameterHandle handle) const
+{
+    return parameters.at(handle).typedValue;
+}
+
+bool ParametersManager::isModified(const ParameterHandle handle) const
+{
+    return parameters.at(handle).newValue.has_value();
+}
+
+bool ParametersManager::isModified(const String &category) const
+{
+    for (const ParameterHandle handle : getCategoryParameters(category))
     {
-        values[parameter.param.name] = parameter.newValue.value_or(parameter.value);
+        if (parameters[handle].newValue.has_value())
+            return true;
     }
-    return values;
+    return false;
 }
 
-const String &ParametersManager::getOriginalValue(const String &category, const String &parameterName) const
+uint32_t ParametersManager::getRevision(const String &category) const
+{
+    const size_t categoryIndex = findCategory(category);
+    if (categoryIndex == categories.size())
+        throw std::out_of_range("No such category!");
+    return categories[categoryIndex].revision;
+}
+
+size_t ParametersManager::countModified(const String &category) const
 {
-    return parameters.at(category).at(parameterName).value;
+    size_t count = 0;
+    for (const ParameterHandle handle : getCategoryParameters(category))
+    {
+        if (parameters[handle].newValue.has_value())
+            count++;
+    }
+    return count;
 }
 
 void ParametersManager::setParameterValue(const String &category, const String &parameterName, const String &value)
 {
-    if (value.equals(getOriginalValue(category, parameterName)))
-        parameters[category].at(parameterName).newValue.reset();
+    setParameterValue(getHandle(category, parameterName), value);
+}
+
+void ParametersManager::setParameterValue(const ParameterHandle handle, const String &value)
+{
+    Parameter &parameter = parameters.at(handle);
+    if (value.equals(getValue(handle)))
+        return;
+    if (value.equals(parameter.value))
+        parameter.newValue.reset();
     else
-        parameters[category].at(parameterName).newValue = value;
+        parameter.newValue = value;
+    parameter.typedValue = TypedValue::parse(parameter.param.type, value, parameter.options.get());
+    parameter.invalidateValidation();
+    categories[parameter.category].revision++;
 }
 
 const ValidationResult ParametersManager::validateValue(const String &category, const String &parameterName, const String &value) const
 {
-    return parameters.at(category).at(parameterName).param.isValid(value);
+    return validateValue(getHandle(category, parameterName), value);
 }
 
-ChainedValidationResults ParametersManager::validateAllValues() const
+const ValidationResult ParametersManager::validateValue(const ParameterHandle handle, const String &value) const
 {
-    ChainedValidationResults result;
-    for (const auto &[_, parametersInCategory] : parameters)
+    const Parameter &parameter = parameters.at(handle);
+    // Validating the current edited value (the common case for input interfaces) can use the memoized result.
+    if (parameter.newValue.has_value() && value.equals(parameter.newValue.value()))
+        return parameter.validateNewValue();
+    return parameter.param.isValid(parameter.param.name, value, TypedValue::parse(parameter.param.type, value, parameter.options.get()), parameter.options);
+}
+
+ChainedValidationResults ParametersManager::validateAllValues(const size_t maxErrors) const
+{
+    ChainedValidationResults result = ChainedValidationResults::WithMaxErrors(maxErrors);
+    for (const Parameter &param : parameters)
     {
-        for (const auto &[paramName, param] : parametersInCategory)
-        {
-            // Skip unmodified parameters
-            if (!param.newValue.has_value())
-                continue;
-            const ValidationResult &error = param.param.isValid(param.newValue.value());
-            result = result && error;
-        }
+        if (result.isFull())
+            break;
+        // Skip unmodified parameters
+        if (!param.newValue.has_value())
+            continue;
+        result && param.validateNewValue();
     }
     return result;
 }
 
-std::vector<String> ParametersManager::Parameter::getOptions(bool refresh)
+size_t ParametersManager::findCategory(const String &category) const
 {
-    if (refresh || !optionsLoaded)
+    // There are only a handful of categories (one per configuration type), a linear scan is the fastest lookup.
+    for (size_t i = 0; i < categories.size(); i++)
     {
-        options = getOptionsForParam(param.name);
-        optionsLoaded = true;
+        if (categories[i].name.equals(category))
+            return i;
     }
-    return options;
+    return categories.size();
+}
+
+size_t ParametersManager::lowerBound(const Category &category, const String &parameterName) const
+{
+    size_t low = 0;
+    size_t high = category.sortedByName.size();
+    while (low < high)
+    {
+        const size_t middle = (low + high) / 2;
+        if (parameters[category.parameters[category.sortedByName[middle]]].param.name < parameterName)
+            low = middle + 1;
+        else
+            high = middle;
+    }
+    return low;
+}
+
+size_t ParametersManager::findInCategory(const Category &category, const String &parameterName) const
+{
+    const size_t position = lowerBound(category, parameterName);
+    if (position < category.sortedByName.size())
+    {
+        const uint16_t candidate = category.sortedByName[position];
+        if (parameters[category.parameters[candidate]].param.name.equals(parameterName))
+            return candidate;
+    }
+    return category.parameters.size();
+}
+
+const std::vector<String> &ParametersManager::Parameter::getOptions(bool refresh)
+{
+    if (!options)
+    {
+        // The validator has no options, they come from the function given to `addParameter`.
+        const auto getOptions = getOptionsForParam;
+        const String name = param.name;
+        options = std::make_shared<OptionSet>([getOptions, name]()
+                                              { return getOptions ? getOptions(name) : std::vector<String>(); });
+    }
+    if (refresh)
+        options->refresh();
+    return options->get();
+}
+
+const ValidationResult &ParametersManager::Parameter::validateNewValue() const
+{
+    // A result computed against options that were fetched again since (or are due to be) may no longer hold.
+    const bool usesOptions = param.isValid.getKind() == Validator::Kind::OPTION_SET;
+    if (validation.has_value() && usesOptions && (options->getRevision() != validationRevision || options->isStale()))
+        validation.reset();
+    if (!validation.has_value())
+    {
+        validation = param.isValid(param.name, newValue.value(), typedValue, options);
+        if (usesOptions)
+            validationRevision = options->getRevision();
+    }
+    return validation.value();
+}
+
+const String &ParameterValuesView::at(const String &parameterName) const
+{
+    const Iterator it = find(parameterName);
+    if (it == end())
+        throw std::out_of_range("No such parameter!");
+    return (*it).value;
+}
+
+const TypedValue &ParameterValuesView::typedAt(const String &parameterName) const
+{
+    const size_t position = manager.findInCategory(category, parameterName);
+    if (position == size())
+        throw std::out_of_range("No such parameter!");
+    return typedAt(position);
+}
+
+ParameterValuesView::Iterator ParameterValuesView::find(const String &parameterName) const
+{
+    return Iterator(*this, manager.findInCategory(category, parameterName));
+}
+
+bool ParameterValuesView::isModified(const String &parameterName) const
+{
+    const size_t position = manager.findInCategory(category, parameterName);
+    return position < size() && manager.parameters[category.parameters[position]].newValue.has_value();
+}
+
+std::map<String, String> ParameterValuesView::toMap() const
+{
+    std::map<String, String> values;
+    for (const auto &[name, value] : *this)
+        values[name] = value;
+    return values;
+}
+
+ParameterValuesView::Entry ParameterValuesView::entryAt(const size_t position) const
+{
+    const ParametersManager::Parameter &parameter = manager.parameters[category.parameters[position]];
+    return {parameter.param.name, parameter.newValue.has_value() ? parameter.newValue.value() : parameter.value};
+}
+
+const TypedValue &ParameterValuesView::typedAt(const size_t position) const
+{
+    return manager.parameters[category.parameters[position]].typedValue;
 }
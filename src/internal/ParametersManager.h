@@ -3,51 +3,292 @@
 #include <WString.h>
 #include <functional>
 #include <map>
+#include <memory>
 #include <optional>
+#include <stdint.h>
+#include <vector>
+#include "TypedValue.h"
 #include "ValidationResult.h"
 #include "../DataStructures.h"
 
+class ParameterValuesView;
+
 /**
  * @brief Consolidates parameters from multiple configurations, offering am interface for interacting with them.
  * It supports operations such as editing parameters values and running validations, thereby simplifying the management of diverse configuration parameters.
  *
+ * Parameters are kept in one contiguous table, and can be accessed in O(1) through the `ParameterHandle` returned by `addParameter` (or `getHandle`).
+ * The functions that take a category and a parameter name look the handle up first (binary search within the category).
+ *
+ * The validation result of each edited value is memoized until the value is changed again with `setParameterValue` (or the parameter's options change),
+ * so validating repeatedly (e.g. on every input) only runs the validators of the parameters that changed since.
+ *
+ * The options of option set parameters are cached here (see `OptionSet`), so they are fetched once per manager (i.e. per input session) and freed with it.
+ *
  */
 class ParametersManager
 {
 public:
-    void addParameter(const String &category, const ParameterInfo &parameter, const String &currentValue, std::function<std::vector<String>(const String &)> getOptions);
+    /// @brief Identifies a parameter in this manager, valid for the manager's lifetime.
+    typedef uint16_t ParameterHandle;
+
+    /**
+     * @param getOptions Returns the options of the parameter (e.g. `ConfigurationFunctions<T>::getOptionsFor`), used only if its validator has none:
+     * the options of an option set validator are shown and validated against, and fetched once for both.
+     */
+    ParameterHandle addParameter(const String &category, const ParameterInfo &parameter, const String &currentValue, std::function<std::vector<String>(const String &)> getOptions);
+
+    /**
+     * @brief Get the handle of a parameter.
+     *
+     * @throws std::out_of_range If there is no such parameter.
+     */
+    ParameterHandle getHandle(const String &category, const String &parameterName) const;
+
+    /**
+     * @brief The handles of all the parameters in the category, in the order they were added.
+     *
+     * @throws std::out_of_range If there is no such category.
+     */
+    const std::vector<ParameterHandle> &getCategoryParameters(const String &category) const;
 
-    std::vector<String> getParameterOptions(const String &category, const String &parameterName, bool refresh = false);
+    /**
+     * @brief The valid options of a parameter of type `ParameterType::TYPE_OPTIONSET`, cached here and shared with its validation:
+     * the options of its validator, or fetched with the function given to `addParameter` if the validator has none.
+     *
+     * @param refresh Fetch the options again instead of using the cached ones.
+     * @return The cached options, valid until they are refreshed.
+     */
+    const std::vector<String> &getParameterOptions(const String &category, const String &parameterName, bool refresh = false);
+    const std::vector<String> &getParameterOptions(const ParameterHandle handle, bool refresh = false);
 
     std::map<String, String> getParametersValues(const String &category) const;
 
+    /**
+     * @brief A read-only view of the values (edited or original) of the category's parameters, that does not copy them.
+     *
+     * The view is invalidated by `addParameter`.
+     *
+     * @throws std::out_of_range If there is no such category.
+     */
+    ParameterValuesView getParametersView(const String &category) const;
+
+    const ParameterInfo &getParameterInfo(const ParameterHandle handle) const;
+
     const String &getOriginalValue(const String &category, const String &parameterName) const;
+    const String &getOriginalValue(const ParameterHandle handle) const;
+
+    /**
+     * @brief The value of the parameter, taking edits into account.
+     */
+    const String &getValue(const ParameterHandle handle) const;
+
+    /**
+     * @brief The parsed form of the parameter's value (taking edits into account), computed when the value was set.
+     */
+    const TypedValue &getTypedValue(const ParameterHandle handle) const;
+
+    /**
+     * @brief Whether the parameter's value was changed from its original value.
+     */
+    bool isModified(const ParameterHandle handle) const;
+
+    /**
+     * @brief Whether any parameter in the category was changed from its original value.
+     *
+     * @throws std::out_of_range If there is no such category.
+     */
+    bool isModified(const String &category) const;
+
+    /**
+     * @brief A counter that changes whenever the value of a parameter in the category changes,
+     * comparing it with a previously read revision tells whether the category's values may have changed since.
+     *
+     * @throws std::out_of_range If there is no such category.
+     */
+    uint32_t getRevision(const String &category) const;
+
+    /**
+     * @brief The number of parameters in the category that were changed from their original value.
+     *
+     * @throws std::out_of_range If there is no such category.
+     */
+    size_t countModified(const String &category) const;
 
     void setParameterValue(const String &category, const String &parameterName, const String &value);
+    void setParameterValue(const ParameterHandle handle, const String &value);
 
     const ValidationResult validateValue(const String &category, const String &parameterName, const String &value) const;
+    const ValidationResult validateValue(const ParameterHandle handle, const String &value) const;
 
-    ChainedValidationResults validateAllValues() const;
+    /**
+     * @brief Validates the values of all the modified parameters.
+     *
+     * @param maxErrors Stop after that many errors (e.g. `ChainedValidationResults::FAIL_FAST`), or `ChainedValidationResults::UNBOUNDED` to validate everything.
+     */
+    ChainedValidationResults validateAllValues(const size_t maxErrors = ChainedValidationResults::UNBOUNDED) const;
 
 private:
+    friend class ParameterValuesView;
+
     class Parameter
     {
     public:
         const ParameterInfo param;
         const String value;
         std::optional<String> newValue;
+        /// @brief Index of the parameter's category in `categories`.
+        const uint16_t category;
+        /// @brief The parsed form of `newValue` if there is one, or of `value` otherwise.
+        TypedValue typedValue;
+
+        /// @brief The options of the parameter, shared by its validation and the input interface: the cache of an option set validator,
+        /// or, for the other validators, created on first use by `getOptions` with `getOptionsForParam` as provider (`nullptr` until then).
+        std::shared_ptr<OptionSet> options;
+
+        Parameter(const ParameterInfo &parameter, const String &currentValue, const uint16_t category, const std::function<std::vector<String>(const String &)> getOptions)
+            : param(parameter), value(currentValue), newValue(std::nullopt), category(category),
+              typedValue(TypedValue::parse(parameter.type, currentValue, nullptr)), options(parameter.isValid.createOptionSet()),
+              getOptionsForParam(getOptions), validation(std::nullopt), validationRevision(0) {}
 
-        Parameter(const ParameterInfo &parameter, const String &currentValue, const std::function<std::vector<String>(const String &)> getOptions)
-            : param(parameter), value(currentValue), getOptionsForParam(getOptions), options(), optionsLoaded(false), newValue(std::nullopt) {}
+        const std::vector<String> &getOptions(bool refresh);
 
-        std::vector<String> getOptions(bool refresh);
+        /**
+         * @brief Validates the edited value, or returns the result of the last validation if neither the value nor the options were changed since.
+         */
+        const ValidationResult &validateNewValue() const;
+
+        /**
+         * @brief Forgets the memoized validation result, must be called whenever `newValue` changes.
+         */
+        void invalidateValidation()
+        {
+            validation.reset();
+        }
 
     private:
+        /// @brief Provides the options of a parameter whose validator has none.
         const std::function<std::vector<String>(const String &)> getOptionsForParam;
-        std::vector<String> options;
-        bool optionsLoaded;
+
+        /// @brief The validation result of the current `newValue`, if it was validated.
+        mutable std::optional<ValidationResult> validation;
+        /// @brief The revision of `options` when `validation` was computed.
+        mutable uint32_t validationRevision;
+    };
+
+    struct Category
+    {
+        String name;
+        /// @brief The category's parameters, in insertion order.
+        std::vector<ParameterHandle> parameters;
+        /// @brief Positions in `parameters`, sorted by the parameters' names for lookups.
+        std::vector<uint16_t> sortedByName;
+        /// @brief Incremented whenever a value in the category changes.
+        uint32_t revision;
+    };
+
+    std::vector<Parameter> parameters;
+    std::vector<Category> categories;
+
+    /**
+     * @brief Index of the category in `categories`, or `categories.size()` if there is no such category.
+     */
+    size_t findCategory(const String &category) const;
+    /**
+     * @brief Index in `category.sortedByName` of the first parameter whose name is not less than `parameterName`.
+     */
+    size_t lowerBound(const Category &category, const String &parameterName) const;
+    /**
+     * @brief Position in `category.parameters` of the parameter named `parameterName`, or `category.parameters.size()` if there is no such parameter.
+     */
+    size_t findInCategory(const Category &category, const String &parameterName) const;
+};
+
+/**
+ * @brief A read-only view of the values of one category in a `ParametersManager`.
+ * Iterating it yields `{name, value}` pairs (by reference) in the order the parameters were added,
+ * where the value is the edited value if there is one, or the original value otherwise.
+ *
+ * Example: `for (const auto &[name, value] : view) {...}`
+ *
+ */
+class ParameterValuesView
+{
+public:
+    struct Entry
+    {
+        const String &name;
+        const String &value;
     };
-    std::map<String, std::map<String, Parameter>> parameters;
+
+    class Iterator
+    {
+    public:
+        Iterator(const ParameterValuesView &view, const size_t position) : view(view), position(position) {}
+
+        Entry operator*() const { return view.entryAt(position); }
+        /**
+         * @brief The parsed form of the current entry's value.
+         */
+        const TypedValue &typed() const { return view.typedAt(position); }
+        Iterator &operator++()
+        {
+            position++;
+            return *this;
+        }
+        bool operator==(const Iterator &other) const { return position == other.position; }
+        bool operator!=(const Iterator &other) const { return position != other.position; }
+
+    private:
+        const ParameterValuesView &view;
+        size_t position;
+    };
+
+    Iterator begin() const { return Iterator(*this, 0); }
+    Iterator end() const { return Iterator(*this, size()); }
+    size_t size() const { return category.parameters.size(); }
+
+    /**
+     * @brief The value of the parameter named `parameterName`.
+     *
+     * @throws std::out_of_range If there is no such parameter in the category.
+     */
+    const String &at(const String &parameterName) const;
+
+    /**
+     * @brief An iterator to the parameter named `parameterName`, or `end()` if there is no such parameter.
+     */
+    Iterator find(const String &parameterName) const;
+
+    size_t count(const String &parameterName) const { return find(parameterName) != end() ? 1 : 0; }
+
+    /**
+     * @brief The parsed form of the value of the parameter named `parameterName`.
+     *
+     * @throws std::out_of_range If there is no such parameter in the category.
+     */
+    const TypedValue &typedAt(const String &parameterName) const;
+
+    /**
+     * @brief Whether the parameter named `parameterName` was changed from its original value (`false` if there is no such parameter).
+     */
+    bool isModified(const String &parameterName) const;
+
+    /**
+     * @brief Copies the values into a map, for code that needs a `std::map<String, String>`.
+     */
+    std::map<String, String> toMap() const;
+
+private:
+    friend class ParametersManager;
+
+    const ParametersManager &manager;
+    const ParametersManager::Category &category;
+
+    ParameterValuesView(const ParametersManager &manager, const ParametersManager::Category &category) : manager(manager), category(category) {}
+
+    Entry entryAt(const size_t position) const;
+    const TypedValue &typedAt(const size_t position) const;
 };
 
-#endif
\ No newline at end of file
+#endif
@@ -0,0 +1,206 @@
+#include <string.h>
+#include "StagedValue.h"
+
+StagedValue::StagedValue(const StorageMedium::BatchEntry &entry) : type(entry.getType()), value(), text()
+{
+    switch (type)
+    {
+    case Type::CHAR:
+        value.c = entry.getValue<int8_t>();
+        break;
+    case Type::UCHAR:
+        value.uc = entry.getValue<uint8_t>();
+        break;
+    case Type::SHORT:
+        value.s = entry.getValue<int16_t>();
+        break;
+    case Type::USHORT:
+        value.us = entry.getValue<uint16_t>();
+        break;
+    case Type::INT:
+        value.i = entry.getValue<int32_t>();
+        break;
+    case Type::UINT:
+        value.ui = entry.getValue<uint32_t>();
+        break;
+    case Type::LONG:
+        value.l = entry.getValue<int64_t>();
+        break;
+    case Type::ULONG:
+        value.ul = entry.getValue<uint64_t>();
+        break;
+    case Type::FLOAT:
+        value.f = entry.getValue<float>();
+        break;
+    case Type::DOUBLE:
+        value.d = entry.getValue<double>();
+        break;
+    case Type::BOOL:
+        value.b = entry.getValue<bool>();
+        break;
+    case Type::STRING:
+        text = entry.getValue<String>();
+        break;
+    }
+}
+
+StagedValue::StagedValue(const Type type, const uint64_t bits) : type(type), value(), text()
+{
+    switch (type)
+    {
+    case Type::CHAR:
+        value.c = static_cast<int8_t>(bits);
+        break;
+    case Type::UCHAR:
+        value.uc = static_cast<uint8_t>(bits);
+        break;
+    case Type::SHORT:
+        value.s = static_cast<int16_t>(bits);
+        break;
+    case Type::USHORT:
+        value.us = static_cast<uint16_t>(bits);
+        break;
+    case Type::INT:
+        value.i = static_cast<int32_t>(bits);
+        break;
+    case Type::UINT:
+        value.ui = static_cast<uint32_t>(bits);
+        break;
+    case Type::LONG:
+        value.l = static_cast<int64_t>(bits);
+        break;
+    case Type::ULONG:
+        value.ul = bits;
+        break;
+    case Type::FLOAT:
+    {
+        const uint32_t floatBits = static_cast<uint32_t>(bits);
+        memcpy(&value.f, &floatBits, sizeof(floatBits));
+        break;
+    }
+    case Type::DOUBLE:
+        memcpy(&value.d, &bits, sizeof(bits));
+        break;
+    case Type::BOOL:
+        value.b = bits != 0;
+        break;
+    case Type::STRING:
+        break;
+    }
+}
+
+uint64_t StagedValue::getBits() const
+{
+    switch (type)
+    {
+    case Type::CHAR:
+        return static_cast<uint8_t>(value.c);
+    case Type::UCHAR:
+        return value.uc;
+    case Type::SHORT:
+        return static_cast<uint16_t>(value.s);
+    case Type::USHORT:
+        return value.us;
+    case Type::INT:
+        return static_cast<uint32_t>(value.i);
+    case Type::UINT:
+        return value.ui;
+    case Type::LONG:
+        return static_cast<uint64_t>(value.l);
+    case Type::ULONG:
+        return value.ul;
+    case Type::FLOAT:
+    {
+        uint32_t floatBits;
+        memcpy(&floatBits, &value.f, sizeof(floatBits));
+        return floatBits;
+    }
+    case Type::DOUBLE:
+    {
+        uint64_t bits;
+        memcpy(&bits, &value.d, sizeof(bits));
+        return bits;
+    }
+    case Type::BOOL:
+        return value.b ? 1 : 0;
+    case Type::STRING:
+        break;
+    }
+    return 0;
+}
+
+StorageMedium::BatchEntry StagedValue::getEntry(const String &key) const
+{
+    switch (type)
+    {
+    case Type::CHAR:
+        return StorageMedium::BatchEntry(key, &value.c);
+    case Type::UCHAR:
+        return StorageMedium::BatchEntry(key, &value.uc);
+    case Type::SHORT:
+        return StorageMedium::BatchEntry(key, &value.s);
+    case Type::USHORT:
+        return StorageMedium::BatchEntry(key, &value.us);
+    case Type::INT:
+        return StorageMedium::BatchEntry(key, &value.i);
+    case Type::UINT:
+        return StorageMedium::BatchEntry(key, &value.ui);
+    case Type::LONG:
+        return StorageMedium::BatchEntry(key, &value.l);
+    case Type::ULONG:
+        return StorageMedium::BatchEntry(key, &value.ul);
+    case Type::FLOAT:
+        return StorageMedium::BatchEntry(key, &value.f);
+    case Type::DOUBLE:
+        return StorageMedium::BatchEntry(key, &value.d);
+    case Type::BOOL:
+        return StorageMedium::BatchEntry(key, &value.b);
+    case Type::STRING:
+        break;
+    }
+    return StorageMedium::BatchEntry(key, &text);
+}
+
+bool StagedValue::copyTo(const StorageMedium::BatchEntry &entry) const
+{
+    if (entry.getType() != type)
+        return false;
+    if (type == Type::STRING)
+        entry.getValue<String>() = text;
+    else
+        // Same type: the variable and the union member have the same size and representation.
+        memcpy(&entry.getValue<uint8_t>(), &value, getSize(type));
+    return true;
+}
+
+bool StagedValue::operator==(const StagedValue &other) const
+{
+    if (type != other.type)
+        return false;
+    return type == Type::STRING ? text == other.text : getBits() == other.getBits();
+}
+
+size_t StagedValue::getSize(const Type type)
+{
+    switch (type)
+    {
+    case Type::CHAR:
+    case Type::UCHAR:
+    case Type::BOOL:
+        return 1;
+    case Type::SHORT:
+    case Type::USHORT:
+        return 2;
+    case Type::INT:
+    case Type::UINT:
+    case Type::FLOAT:
+        return 4;
+    case Type::LONG:
+    case Type::ULONG:
+    case Type::DOUBLE:
+        return 8;
+    case Type::STRING:
+        return 0;
+    }
+    return 0;
+}
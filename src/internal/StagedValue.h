@@ -0,0 +1,80 @@
+#ifndef __H_STAGED_VALUE__
+#define __H_STAGED_VALUE__
+#include <WString.h>
+#include <stdint.h>
+#include "../StorageMedium.h"
+
+/**
+ * @brief A copy of the value of a `StorageMedium::BatchEntry`, with its type, kept until it is written to a medium.
+ *
+ */
+class StagedValue
+{
+public:
+    typedef StorageMedium::BatchEntry::Type Type;
+
+    StagedValue() : type(Type::BOOL), value(), text() {}
+
+    /**
+     * @brief Copies the value of `entry`.
+     */
+    explicit StagedValue(const StorageMedium::BatchEntry &entry);
+
+    /**
+     * @brief A value of a non-string type, from its bits (see `getBits`).
+     */
+    StagedValue(const Type type, const uint64_t bits);
+
+    explicit StagedValue(const String &text) : type(Type::STRING), value(), text(text) {}
+
+    Type getType() const { return type; }
+
+    /**
+     * @brief The value of a non-string type as an integer of its size, zero-extended (floats are their IEEE-754 bits), `0` for strings.
+     */
+    uint64_t getBits() const;
+
+    const String &getText() const { return text; }
+
+    /**
+     * @brief An entry that writes this value to `key` (both must outlive the entry).
+     */
+    StorageMedium::BatchEntry getEntry(const String &key) const;
+
+    /**
+     * @brief Copies this value into the variable of `entry`, if the types match.
+     *
+     * @return false if `entry` is of another type (its variable is left unchanged).
+     */
+    bool copyTo(const StorageMedium::BatchEntry &entry) const;
+
+    bool operator==(const StagedValue &other) const;
+    bool operator!=(const StagedValue &other) const { return !(*this == other); }
+
+    /**
+     * @brief The size of a value of type `type` in bytes, `0` for strings.
+     */
+    static size_t getSize(const Type type);
+
+private:
+    union Value
+    {
+        int8_t c;
+        uint8_t uc;
+        int16_t s;
+        uint16_t us;
+        int32_t i;
+        uint32_t ui;
+        int64_t l;
+        uint64_t ul;
+        float f;
+        double d;
+        bool b;
+    };
+
+    Type type;
+    Value value;
+    String text;
+};
+
+#endif // __H_STAGED_VALUE__
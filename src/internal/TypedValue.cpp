@@ -0,0 +1,56 @@
+#include "TypedValue.h"
+#include "string-utils.h"
+
+TypedValue TypedValue::parse(const ParameterType type, const String &text, const OptionSet *options)
+{
+    TypedValue value;
+    switch (type)
+    {
+    case ParameterType::TYPE_INT:
+    {
+        int64_t result;
+        if (tryParseInt64(text.c_str(), text.length(), &result))
+        {
+            value.kind = Kind::INT;
+            value.data.intValue = result;
+        }
+        break;
+    }
+    case ParameterType::TYPE_FLOAT:
+    {
+        double result;
+        if (tryParseDouble(text.c_str(), text.length(), &result))
+        {
+            value.kind = Kind::FLOAT;
+            value.data.floatValue = result;
+        }
+        break;
+    }
+    case ParameterType::TYPE_BOOL:
+        if (text.equalsIgnoreCase("true") || text.equalsIgnoreCase("false"))
+        {
+            value.kind = Kind::BOOL;
+            value.data.boolValue = text.equalsIgnoreCase("true");
+        }
+        break;
+    case ParameterType::TYPE_OPTIONSET:
+    {
+        // Don't fetch the options just for this (it may be a slow scan), they are resolved when validating.
+        const int index = options ? options->indexOfCached(text) : -1;
+        if (index >= 0)
+        {
+            value.kind = Kind::OPTION;
+            value.data.option.index = static_cast<uint16_t>(index);
+            value.data.option.revision = options->getRevision();
+        }
+        else
+            value.kind = Kind::STRING;
+        break;
+    }
+    case ParameterType::TYPE_STRING:
+    case ParameterType::TYPE_DATE:
+        value.kind = Kind::STRING;
+        break;
+    }
+    return value;
+}
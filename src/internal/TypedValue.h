@@ -0,0 +1,81 @@
+#ifndef __H_TYPED_VALUE__
+#define __H_TYPED_VALUE__
+#include <WString.h>
+#include <stdint.h>
+#include "../DataStructures.h"
+
+/**
+ * @brief The parsed form of a parameter's value, according to the parameter's type.
+ * It is computed once when the value is set, so validators and save functions do not parse the text again.
+ *
+ * A value that could not be parsed (e.g. "abc" for an integer parameter) has the kind `NONE`,
+ * and option values are only resolved to their index if the options were already fetched (otherwise they are `STRING`).
+ *
+ */
+class TypedValue
+{
+public:
+    enum class Kind : uint8_t
+    {
+        /// @brief The text is not valid for the parameter's type.
+        NONE,
+        INT,
+        FLOAT,
+        BOOL,
+        /// @brief The position of the value in the parameter's options.
+        OPTION,
+        /// @brief No parsed form, the text is the value.
+        STRING,
+    };
+
+    TypedValue() : kind(Kind::NONE), data() {}
+
+    /**
+     * @brief Parses `text` as a value of a parameter of type `type`.
+     *
+     * @param options The parameter's options (for `ParameterType::TYPE_OPTIONSET`), may be `nullptr`.
+     * They are not fetched: the value is only resolved to a position if the options are loaded and not stale.
+     */
+    static TypedValue parse(const ParameterType type, const String &text, const OptionSet *options);
+
+    Kind getKind() const { return kind; }
+
+    /**
+     * @brief Unsafe access to the value of an `INT` value.
+     */
+    int64_t asInt() const { return data.intValue; }
+    /**
+     * @brief Unsafe access to the value of a `FLOAT` value.
+     */
+    double asFloat() const { return data.floatValue; }
+    /**
+     * @brief Unsafe access to the value of a `BOOL` value.
+     */
+    bool asBool() const { return data.boolValue; }
+    /**
+     * @brief Unsafe access to the position of an `OPTION` value in the parameter's options.
+     */
+    uint16_t getOptionIndex() const { return data.option.index; }
+    /**
+     * @brief The revision of the options in which `getOptionIndex` was found (see `OptionSet::getRevision`).
+     */
+    uint32_t getOptionsRevision() const { return data.option.revision; }
+
+private:
+    Kind kind;
+    union Data
+    {
+        int64_t intValue;
+        double floatValue;
+        bool boolValue;
+        struct
+        {
+            uint16_t index;
+            uint32_t revision;
+        } option;
+
+        Data() : intValue(0) {}
+    } data;
+};
+
+#endif // __H_TYPED_VALUE__
@@ -0,0 +1,87 @@
+#include "ValidationResult.h"
+#include "OptionSet.h"
+#include "string-utils.h"
+
+ValidationResult ValidationResult::IntOutOfRange(const String &name, const String &value, const int64_t min, const int64_t max)
+{
+    ValidationResult result(Code::INT_OUT_OF_RANGE, name, value);
+    result.arguments.integers[0] = min;
+    result.arguments.integers[1] = max;
+    return result;
+}
+
+ValidationResult ValidationResult::UIntOutOfRange(const String &name, const String &value, const uint64_t min, const uint64_t max)
+{
+    ValidationResult result(Code::UINT_OUT_OF_RANGE, name, value);
+    result.arguments.unsignedIntegers[0] = min;
+    result.arguments.unsignedIntegers[1] = max;
+    return result;
+}
+
+ValidationResult ValidationResult::FloatOutOfRange(const String &name, const String &value, const float min, const float max)
+{
+    ValidationResult result(Code::FLOAT_OUT_OF_RANGE, name, value);
+    result.arguments.reals[0] = min;
+    result.arguments.reals[1] = max;
+    return result;
+}
+
+ValidationResult ValidationResult::DoubleOutOfRange(const String &name, const String &value, const double min, const double max)
+{
+    ValidationResult result(Code::DOUBLE_OUT_OF_RANGE, name, value);
+    result.arguments.reals[0] = min;
+    result.arguments.reals[1] = max;
+    return result;
+}
+
+ValidationResult ValidationResult::NotABoolean(const String &name)
+{
+    return ValidationResult(Code::NOT_A_BOOLEAN, name, String());
+}
+
+ValidationResult ValidationResult::NotAnOption(const String &name, const String &value, const std::shared_ptr<OptionSet> &options)
+{
+    ValidationResult result(Code::NOT_AN_OPTION, name, value);
+    result.options = options;
+    result.optionsRevision = options ? options->getRevision() : 0;
+    return result;
+}
+
+ValidationResult ValidationResult::TooLong(const String &name, const unsigned long maxLength)
+{
+    ValidationResult result(Code::TOO_LONG, name, String());
+    result.arguments.unsignedIntegers[0] = maxLength;
+    return result;
+}
+
+String ValidationResult::render() const
+{
+    // Results of validators called without the parameter's name don't name it.
+    const String prefix = name.isEmpty() ? String() : String(name + ": ");
+    switch (code)
+    {
+    case Code::SUCCESS:
+        return String();
+    case Code::INT_OUT_OF_RANGE:
+        return prefix + "value (" + value + ") is out of range [" + static_cast<long long>(arguments.integers[0]) + ", " + static_cast<long long>(arguments.integers[1]) + "]";
+    case Code::UINT_OUT_OF_RANGE:
+        return prefix + "value (" + value + ") is out of range [" + static_cast<unsigned long long>(arguments.unsignedIntegers[0]) + ", " + static_cast<unsigned long long>(arguments.unsignedIntegers[1]) + "]";
+    case Code::FLOAT_OUT_OF_RANGE:
+        return prefix + "value (" + value + ") is out of range [" + static_cast<float>(arguments.reals[0]) + ", " + static_cast<float>(arguments.reals[1]) + "]";
+    case Code::DOUBLE_OUT_OF_RANGE:
+        return prefix + "value (" + value + ") is out of range [" + formatDouble(arguments.reals[0]) + ", " + formatDouble(arguments.reals[1]) + "]";
+    case Code::NOT_A_BOOLEAN:
+        return prefix + "value must be true/false";
+    case Code::NOT_AN_OPTION:
+        // The options validated against are gone once they were fetched again.
+        if (!options || options->getRevision() != optionsRevision)
+            return prefix + value + " is invalid, the options changed since it was validated";
+        return prefix + value + " is invalid, options are: [" + vectorToString(options->getCached()) + "]";
+    case Code::TOO_LONG:
+        return prefix + "value's length must be less than " + static_cast<unsigned long>(arguments.unsignedIntegers[0]);
+    case Code::MESSAGE:
+        break;
+    }
+    // The message of `Failure` is set on construction.
+    return message.value_or(String());
+}
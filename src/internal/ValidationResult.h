@@ -2,17 +2,39 @@
 #define __H_VALIDATION_RESULT__
 #include <WString.h>
 #include <functional>
+#include <memory>
 #include <optional>
+#include <stdint.h>
 #include <vector>
 
+class OptionSet;
+
 /**
  * @brief Represents the outcome of a validation process, it indicates whether the validation was successful or not.
- * In the case of a failure, this class instance holds an error message detailing the reason for the failure.
+ * In the case of a failure, this class instance holds an error code and its arguments, the error message detailing the reason for the failure
+ * is only rendered when it is requested (`getError`), so checking the result does not build any strings.
  *
  */
 class ValidationResult
 {
 public:
+    /**
+     * @brief The reason of a validation failure, which determines how the error message is rendered.
+     */
+    enum class Code : uint8_t
+    {
+        SUCCESS,
+        /// @brief A failure with a ready-made message (`Failure`).
+        MESSAGE,
+        INT_OUT_OF_RANGE,
+        UINT_OUT_OF_RANGE,
+        FLOAT_OUT_OF_RANGE,
+        DOUBLE_OUT_OF_RANGE,
+        NOT_A_BOOLEAN,
+        NOT_AN_OPTION,
+        TOO_LONG,
+    };
+
     /**
      * @brief A singleton instance to represent a success state.
      *
@@ -32,26 +54,71 @@ public:
      */
     static ValidationResult Failure(const String &errorMessage)
     {
-        return ValidationResult(errorMessage);
+        ValidationResult result(Code::MESSAGE, String(), String());
+        result.message = errorMessage;
+        return result;
     }
 
+    /**
+     * @brief The value of parameter `name` is not an integer in the range [`min`, `max`].
+     */
+    static ValidationResult IntOutOfRange(const String &name, const String &value, const int64_t min, const int64_t max);
+
+    /**
+     * @brief The value of parameter `name` is not an unsigned integer in the range [`min`, `max`].
+     */
+    static ValidationResult UIntOutOfRange(const String &name, const String &value, const uint64_t min, const uint64_t max);
+
+    /**
+     * @brief The value of parameter `name` is not a number in the range [`min`, `max`].
+     */
+    static ValidationResult FloatOutOfRange(const String &name, const String &value, const float min, const float max);
+
+    /**
+     * @brief The value of parameter `name` is not a number in the range [`min`, `max`] (with double precision).
+     */
+    static ValidationResult DoubleOutOfRange(const String &name, const String &value, const double min, const double max);
+
+    /**
+     * @brief The value of parameter `name` is neither "true" nor "false".
+     */
+    static ValidationResult NotABoolean(const String &name);
+
+    /**
+     * @brief The value of parameter `name` is not one of `options`, as of their current revision.
+     * The error message lists the options only if they were not fetched again since, rendering it never fetches them.
+     */
+    static ValidationResult NotAnOption(const String &name, const String &value, const std::shared_ptr<OptionSet> &options);
+
+    /**
+     * @brief The value of parameter `name` is longer than `maxLength`.
+     */
+    static ValidationResult TooLong(const String &name, const unsigned long maxLength);
+
     bool isSuccess() const
     {
-        return !result.has_value();
+        return code == Code::SUCCESS;
     }
     bool isFailure() const
     {
         return !isSuccess();
     }
 
+    Code getCode() const
+    {
+        return code;
+    }
+
     /**
-     * @brief Unsafe access to the error message.
+     * @brief Unsafe access to the error message, which is rendered on the first call.
      *
      * @return String - The error message attached to this validation result.
      */
     const String &getError() const
     {
-        return result.value();
+        if (!message.has_value())
+            message = render();
+        return message.value();
     }
 
     /**
@@ -65,7 +132,7 @@ public:
         if (isSuccess())
             onSuccess();
         else
-            onFail(result.value());
+            onFail(getError());
     }
 
     /**
@@ -82,30 +149,78 @@ public:
         if (isSuccess())
             return onSuccess();
         else
-            return onFail(result.value());
+            return onFail(getError());
     }
 
 private:
-    const std::optional<String> result;
+    Code code;
+    /// @brief The revision of `options` the value was validated against.
+    uint32_t optionsRevision;
+    /// @brief The name of the parameter, empty if the validator was not given one.
+    String name;
+    /// @brief The invalid value (short values are stored inline by `String`).
+    String value;
+    /// @brief The arguments of the error message, which one is set depends on `code`.
+    union
+    {
+        int64_t integers[2];
+        uint64_t unsignedIntegers[2];
+        double reals[2];
+    } arguments;
+    std::shared_ptr<OptionSet> options;
+    /// @brief The error message, rendered on demand (or given to `Failure`).
+    mutable std::optional<String> message;
 
-    ValidationResult() : result(std::nullopt) {}
-    ValidationResult(const String &error) : result(error) {}
+    ValidationResult() : ValidationResult(Code::SUCCESS, String(), String()) {}
+    ValidationResult(const Code code, const String &name, const String &value)
+        : code(code), optionsRevision(0), name(name), value(value), arguments{{0, 0}}, options(), message(std::nullopt) {}
+
+    String render() const;
 };
 
 /**
  * @brief Concatenate multiple validation results into a single structure. Maintains a list of all errors encountered during the validation process,
  * while also indicating overall success or failure.
  *
+ * The number of kept errors can be bounded (`WithMaxErrors`): once `maxErrors` errors were added the chain is full (`isFull`),
+ * further results are ignored and the code building the chain can stop validating.
+ * Use `FAIL_FAST` when only a yes/no answer is needed.
+ *
  */
 class ChainedValidationResults
 {
 public:
-    ChainedValidationResults(int maxErrors = 0) : errors() { errors.reserve(maxErrors); }
-    ChainedValidationResults(const std::vector<String> &errors) : errors(errors) {}
+    /// @brief Keep every error.
+    static constexpr size_t UNBOUNDED = 0;
+    /// @brief Stop at the first error.
+    static constexpr size_t FAIL_FAST = 1;
+
+    /**
+     * @param capacity The number of errors to reserve room for, every error is kept.
+     */
+    ChainedValidationResults(int capacity = 0) : maxErrors(UNBOUNDED), failures(), errors() { failures.reserve(capacity); }
+    ChainedValidationResults(const std::vector<String> &errors) : maxErrors(UNBOUNDED), failures(), errors()
+    {
+        failures.reserve(errors.size());
+        for (const String &error : errors)
+            failures.push_back(ValidationResult::Failure(error));
+    }
+
+    /**
+     * @brief A chain that keeps at most `maxErrors` errors.
+     *
+     * @param maxErrors The maximum number of errors to keep, `UNBOUNDED` to keep them all.
+     */
+    static ChainedValidationResults WithMaxErrors(const size_t maxErrors)
+    {
+        ChainedValidationResults results;
+        results.maxErrors = maxErrors;
+        return results;
+    }
 
     bool isSuccess() const
     {
-        return errors.empty();
+        return failures.empty();
     }
     bool isFailure() const
     {
@@ -113,12 +228,40 @@ public:
     }
 
     /**
-     * @brief Unsafe access to the error messages.
+     * @brief Whether the maximum number of errors was reached, in which case there is no need to validate anything else.
+     */
+    bool isFull() const
+    {
+        return maxErrors != UNBOUNDED && failures.size() >= maxErrors;
+    }
+
+    size_t getMaxErrors() const
+    {
+        return maxErrors;
+    }
+
+    /**
+     * @brief The failed validation results, whose messages are not rendered yet.
+     */
+    const std::vector<ValidationResult> &getFailures() const
+    {
+        return failures;
+    }
+
+    /**
+     * @brief Unsafe access to the error messages, which are rendered on the first call.
      *
      * @return The list of error messages for this validation result, or an empty list in case of a successful result.
      */
     const std::vector<String> &getErrors() const
     {
+        if (errors.size() != failures.size())
+        {
+            errors.clear();
+            errors.reserve(failures.size());
+            for (const ValidationResult &failure : failures)
+                errors.push_back(failure.getError());
+        }
         return errors;
     }
 
@@ -133,7 +276,7 @@ public:
         if (isSuccess())
             onSuccess();
         else
-            onFail(errors);
+            onFail(getErrors());
     }
 
     /**
@@ -150,24 +293,27 @@ public:
         if (isSuccess())
             return onSuccess();
         else
-            return onFail(errors);
+            return onFail(getErrors());
     }
 
     /**
-     * @brief Concatenate the validation result to this results chain.
+     * @brief Concatenate the validation result to this results chain (ignored if the chain is full).
      *
      * @param result - The result to append.
      * @return ChainedValidationResults& - This instance.
      */
     ChainedValidationResults &operator&&(const ValidationResult &result)
     {
-        if (!result.isSuccess())
-            errors.push_back(result.getError());
+        if (!result.isSuccess() && !isFull())
+            failures.push_back(result);
         return *this;
     }
 
 private:
-    std::vector<String> errors;
+    size_t maxErrors;
+    std::vector<ValidationResult> failures;
+    /// @brief The rendered messages of `failures`.
+    mutable std::vector<String> errors;
 };
 
 #endif // __H_VALIDATION_RESULT__
@@ -0,0 +1,220 @@
+#include "Validator.h"
+#include "Fnv1a.h"
+#include "TypedValue.h"
+#include "string-utils.h"
+
+Validator Validator::IntRange(const int64_t min, const int64_t max)
+{
+    Validator validator(Kind::INT_RANGE);
+    validator.data.intRange.min = min;
+    validator.data.intRange.max = max;
+    return validator;
+}
+
+Validator Validator::UIntRange(const uint64_t min, const uint64_t max)
+{
+    Validator validator(Kind::UINT_RANGE);
+    validator.data.uintRange.min = min;
+    validator.data.uintRange.max = max;
+    return validator;
+}
+
+Validator Validator::FloatRange(const float min, const float max)
+{
+    Validator validator(Kind::FLOAT_RANGE);
+    validator.data.floatRange.min = min;
+    validator.data.floatRange.max = max;
+    return validator;
+}
+
+Validator Validator::DoubleRange(const double min, const double max)
+{
+    Validator validator(Kind::DOUBLE_RANGE);
+    validator.data.doubleRange.min = min;
+    validator.data.doubleRange.max = max;
+    return validator;
+}
+
+Validator Validator::Boolean()
+{
+    return Validator(Kind::BOOLEAN);
+}
+
+Validator Validator::MaxLength(const uint32_t maxLength)
+{
+    Validator validator(Kind::MAX_LENGTH);
+    validator.data.maxLength = maxLength;
+    return validator;
+}
+
+Validator Validator::OneOf(const OptionSet::Provider &provider, const unsigned long refreshIntervalMs)
+{
+    if (!provider)
+        return Validator();
+    Validator validator;
+    validator.data.shared.callable = new Shared<OptionSet::Provider>(provider);
+    validator.data.shared.refreshIntervalMs = refreshIntervalMs;
+    // Only once the provider is held, so the validator never releases a callable it does not have.
+    validator.kind = Kind::OPTION_SET;
+    return validator;
+}
+
+void Validator::addToHash(uint32_t &hash) const
+{
+    Fnv1a::add(hash, static_cast<uint8_t>(kind));
+    switch (kind)
+    {
+    case Kind::INT_RANGE:
+        Fnv1a::add(hash, reinterpret_cast<const uint8_t *>(&data.intRange), sizeof(data.intRange));
+        break;
+    case Kind::UINT_RANGE:
+        Fnv1a::add(hash, reinterpret_cast<const uint8_t *>(&data.uintRange), sizeof(data.uintRange));
+        break;
+    case Kind::FLOAT_RANGE:
+        Fnv1a::add(hash, reinterpret_cast<const uint8_t *>(&data.floatRange), sizeof(data.floatRange));
+        break;
+    case Kind::DOUBLE_RANGE:
+        Fnv1a::add(hash, reinterpret_cast<const uint8_t *>(&data.doubleRange), sizeof(data.doubleRange));
+        break;
+    case Kind::MAX_LENGTH:
+        Fnv1a::add(hash, reinterpret_cast<const uint8_t *>(&data.maxLength), sizeof(data.maxLength));
+        break;
+    default:
+        break;
+    }
+}
+
+std::shared_ptr<OptionSet> Validator::createOptionSet() const
+{
+    if (kind != Kind::OPTION_SET)
+        return nullptr;
+    return std::make_shared<OptionSet>(getCallable<OptionSet::Provider>(), data.shared.refreshIntervalMs);
+}
+
+std::vector<String> Validator::fetchOptions() const
+{
+    if (kind != Kind::OPTION_SET)
+        return {};
+    return getCallable<OptionSet::Provider>()();
+}
+
+const ValidationResult Validator::operator()(const String &value) const
+{
+    return validate(String(), value, nullptr);
+}
+
+const ValidationResult Validator::operator()(const String &name, const String &value) const
+{
+    return validate(name, value, nullptr);
+}
+
+const ValidationResult Validator::validate(const String &name, const String &value, const std::shared_ptr<OptionSet> &options) const
+{
+    switch (kind)
+    {
+    case Kind::NONE:
+        return ValidationResult::Success();
+    case Kind::INT_RANGE:
+    {
+        int64_t result;
+        if (tryParseInt64(value.c_str(), value.length(), &result) && result >= data.intRange.min && result <= data.intRange.max)
+            return ValidationResult::Success();
+        return ValidationResult::IntOutOfRange(name, value, data.intRange.min, data.intRange.max);
+    }
+    case Kind::UINT_RANGE:
+    {
+        uint64_t result;
+        if (tryParseUInt64(value.c_str(), value.length(), &result) && result >= data.uintRange.min && result <= data.uintRange.max)
+            return ValidationResult::Success();
+        return ValidationResult::UIntOutOfRange(name, value, data.uintRange.min, data.uintRange.max);
+    }
+    case Kind::FLOAT_RANGE:
+    {
+        float result;
+        if (tryGetFloat(value, &result) && result >= data.floatRange.min && result <= data.floatRange.max)
+            return ValidationResult::Success();
+        return ValidationResult::FloatOutOfRange(name, value, data.floatRange.min, data.floatRange.max);
+    }
+    case Kind::DOUBLE_RANGE:
+    {
+        double result;
+        if (tryParseDouble(value.c_str(), value.length(), &result) && result >= data.doubleRange.min && result <= data.doubleRange.max)
+            return ValidationResult::Success();
+        return ValidationResult::DoubleOutOfRange(name, value, data.doubleRange.min, data.doubleRange.max);
+    }
+    case Kind::BOOLEAN:
+        if (value.equalsIgnoreCase("true") || value.equalsIgnoreCase("false"))
+            return ValidationResult::Success();
+        return ValidationResult::NotABoolean(name);
+    case Kind::MAX_LENGTH:
+        if (value.length() <= data.maxLength)
+            return ValidationResult::Success();
+        return ValidationResult::TooLong(name, data.maxLength);
+    case Kind::OPTION_SET:
+    {
+        const std::shared_ptr<OptionSet> cache = options ? options : createOptionSet();
+        if (cache->contains(value) || cache->get().empty())
+            return ValidationResult::Success();
+        return ValidationResult::NotAnOption(name, value, cache);
+    }
+    case Kind::FUNCTION:
+        return data.function(value);
+    case Kind::CUSTOM:
+        return getCallable<CustomFunction>()(value);
+    }
+    return ValidationResult::Success();
+}
+
+const ValidationResult Validator::operator()(const String &name, const String &value, const TypedValue &typedValue, const std::shared_ptr<OptionSet> &options) const
+{
+    switch (kind)
+    {
+    case Kind::INT_RANGE:
+        if (typedValue.getKind() == TypedValue::Kind::INT)
+        {
+            if (typedValue.asInt() >= data.intRange.min && typedValue.asInt() <= data.intRange.max)
+                return ValidationResult::Success();
+            return ValidationResult::IntOutOfRange(name, value, data.intRange.min, data.intRange.max);
+        }
+        break;
+    case Kind::UINT_RANGE:
+        // Values above INT64_MAX are not parsed as INT, they are parsed again below.
+        if (typedValue.getKind() == TypedValue::Kind::INT)
+        {
+            const int64_t number = typedValue.asInt();
+            if (number >= 0 && static_cast<uint64_t>(number) >= data.uintRange.min && static_cast<uint64_t>(number) <= data.uintRange.max)
+                return ValidationResult::Success();
+            return ValidationResult::UIntOutOfRange(name, value, data.uintRange.min, data.uintRange.max);
+        }
+        break;
+    case Kind::FLOAT_RANGE:
+        if (typedValue.getKind() == TypedValue::Kind::FLOAT)
+        {
+            const float number = static_cast<float>(typedValue.asFloat());
+            if (number >= data.floatRange.min && number <= data.floatRange.max)
+                return ValidationResult::Success();
+            return ValidationResult::FloatOutOfRange(name, value, data.floatRange.min, data.floatRange.max);
+        }
+        break;
+    case Kind::DOUBLE_RANGE:
+        if (typedValue.getKind() == TypedValue::Kind::FLOAT)
+        {
+            if (typedValue.asFloat() >= data.doubleRange.min && typedValue.asFloat() <= data.doubleRange.max)
+                return ValidationResult::Success();
+            return ValidationResult::DoubleOutOfRange(name, value, data.doubleRange.min, data.doubleRange.max);
+        }
+        break;
+    case Kind::BOOLEAN:
+        if (typedValue.getKind() == TypedValue::Kind::BOOL)
+            return ValidationResult::Success();
+        break;
+    case Kind::OPTION_SET:
+        // The position is only meaningful if the options were not fetched again since, and are not due to be.
+        if (options && typedValue.getKind() == TypedValue::Kind::OPTION && typedValue.getOptionsRevision() == options->getRevision() && !options->isStale())
+            return ValidationResult::Success();
+        break;
+    default:
+        break;
+    }
+    return validate(name, value, options);
+}
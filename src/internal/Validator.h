@@ -0,0 +1,247 @@
+#ifndef __H_VALIDATOR__
+#define __H_VALIDATOR__
+#include <WString.h>
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <stdint.h>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include "OptionSet.h"
+#include "ValidationResult.h"
+
+class TypedValue;
+
+/**
+ * @brief The validation function of a parameter, called like a function: `param.isValid(value)`.
+ *
+ * The built-in kinds of validation (integer and float ranges, booleans, max length and option sets) are plain data evaluated by a switch,
+ * they do not allocate a closure and are not called through type erasure.
+ * Any other callable (e.g. the validation functions given to `customParameter`) and the provider of an option set are kept behind a pointer,
+ * shared by the copies of the validator, so a validator is no bigger than the `std::function` it would otherwise hold.
+ * The parameter's name is not stored, it is passed when validating (`param.isValid(param.name, value)`) and only copied into failed results.
+ *
+ */
+class Validator
+{
+public:
+    enum class Kind : uint8_t
+    {
+        /// @brief Every value is valid.
+        NONE,
+        INT_RANGE,
+        UINT_RANGE,
+        FLOAT_RANGE,
+        DOUBLE_RANGE,
+        BOOLEAN,
+        MAX_LENGTH,
+        OPTION_SET,
+        /// @brief A plain function pointer.
+        FUNCTION,
+        /// @brief Any other callable.
+        CUSTOM,
+    };
+
+    typedef const ValidationResult (*Function)(const String &value);
+
+    /**
+     * @brief A validator for which every value is valid.
+     */
+    Validator() : kind(Kind::NONE), data() {}
+    Validator(std::nullptr_t) : Validator() {}
+
+    Validator(const Validator &other) : kind(other.kind), data(other.data) { retain(); }
+    Validator(Validator &&other) noexcept : kind(other.kind), data(other.data) { other.kind = Kind::NONE; }
+    ~Validator() { release(); }
+
+    Validator &operator=(Validator other) noexcept
+    {
+        std::swap(kind, other.kind);
+        std::swap(data, other.data);
+        return *this;
+    }
+
+    Validator(const Function function) : Validator()
+    {
+        if (function)
+        {
+            kind = Kind::FUNCTION;
+            data.function = function;
+        }
+    }
+
+    /**
+     * @brief A validator that calls `function`, which returns a `ValidationResult` for a `const String &` value.
+     */
+    template <typename F, typename = std::enable_if_t<!std::is_same<std::decay_t<F>, Validator>::value && std::is_invocable_r<ValidationResult, F, const String &>::value>>
+    Validator(F &&function) : Validator()
+    {
+        CustomFunction custom = std::forward<F>(function);
+        if (custom)
+        {
+            data.shared.callable = new Shared<CustomFunction>(std::move(custom));
+            kind = Kind::CUSTOM;
+        }
+    }
+
+    /**
+     * @brief Valid values are integers in the range [`min`, `max`].
+     */
+    static Validator IntRange(const int64_t min, const int64_t max);
+
+    /**
+     * @brief Valid values are unsigned integers in the range [`min`, `max`].
+     */
+    static Validator UIntRange(const uint64_t min, const uint64_t max);
+
+    /**
+     * @brief Valid values are numbers in the range [`min`, `max`].
+     */
+    static Validator FloatRange(const float min, const float max);
+
+    /**
+     * @brief Valid values are numbers in the range [`min`, `max`], parsed with double precision.
+     */
+    static Validator DoubleRange(const double min, const double max);
+
+    /**
+     * @brief Valid values are "true" and "false" (case insensitive).
+     */
+    static Validator Boolean();
+
+    /**
+     * @brief Valid values are no longer than `maxLength` characters.
+     */
+    static Validator MaxLength(const uint32_t maxLength);
+
+    /**
+     * @brief Valid values are the options returned by `provider` (every value is valid if there are no options).
+     * The validator does not keep the options, they are cached by an `OptionSet` made with `createOptionSet` (e.g. one per input session).
+     *
+     * @param refreshIntervalMs The refresh interval of the option sets made with `createOptionSet`.
+     */
+    static Validator OneOf(const OptionSet::Provider &provider, const unsigned long refreshIntervalMs = 0);
+
+    Kind getKind() const { return kind; }
+
+    /**
+     * @brief Whether some values are invalid, i.e. this is not a validator for which every value is valid.
+     */
+    explicit operator bool() const { return kind != Kind::NONE; }
+
+    /**
+     * @brief Adds the kind of the validator to the FNV-1a hash `hash`, with the bounds of a range or the max length.
+     * The callables of the `FUNCTION`, `CUSTOM` and `OPTION_SET` kinds cannot be hashed, only their kind is.
+     */
+    void addToHash(uint32_t &hash) const;
+
+    /**
+     * @brief A new cache of the options of an `OPTION_SET` validator, owned by the caller, or `nullptr` for the other kinds.
+     */
+    std::shared_ptr<OptionSet> createOptionSet() const;
+
+    /**
+     * @brief The options of an `OPTION_SET` validator, fetched now (empty for the other kinds).
+     */
+    std::vector<String> fetchOptions() const;
+
+    /**
+     * @brief Validates `value`, the error messages of the built-in kinds do not name the parameter.
+     * An `OPTION_SET` validator fetches the options for this call only.
+     */
+    const ValidationResult operator()(const String &value) const;
+
+    /**
+     * @brief Validates `value` of the parameter `name`, which the error messages of the built-in kinds refer to.
+     * An `OPTION_SET` validator fetches the options for this call only.
+     */
+    const ValidationResult operator()(const String &name, const String &value) const;
+
+    /**
+     * @brief Validates a value whose parsed form is already known, the built-in kinds use `typedValue` instead of parsing `value` again.
+     *
+     * @param name The parameter's name, for the error messages of the built-in kinds.
+     * @param options The cache of the options made with `createOptionSet`, or `nullptr` to fetch them for this call only.
+     */
+    const ValidationResult operator()(const String &name, const String &value, const TypedValue &typedValue, const std::shared_ptr<OptionSet> &options = nullptr) const;
+
+private:
+    typedef std::function<ValidationResult(const String &value)> CustomFunction;
+
+    /**
+     * @brief The callable of a `CUSTOM` validator (`Shared<CustomFunction>`) or the provider of an `OPTION_SET` validator (`Shared<OptionSet::Provider>`),
+     * counted by the validators that refer to it.
+     */
+    struct Callable
+    {
+        std::atomic<uint32_t> references{1};
+        virtual ~Callable() = default;
+    };
+
+    template <typename F>
+    struct Shared : Callable
+    {
+        const F function;
+
+        Shared(F function) : function(std::move(function)) {}
+    };
+
+    Kind kind;
+    union Data
+    {
+        struct
+        {
+            int64_t min;
+            int64_t max;
+        } intRange;
+        struct
+        {
+            uint64_t min;
+            uint64_t max;
+        } uintRange;
+        struct
+        {
+            float min;
+            float max;
+        } floatRange;
+        struct
+        {
+            double min;
+            double max;
+        } doubleRange;
+        uint32_t maxLength;
+        /// @brief `CUSTOM` and `OPTION_SET` (`refreshIntervalMs` is only used by the latter).
+        struct
+        {
+            Callable *callable;
+            unsigned long refreshIntervalMs;
+        } shared;
+        Function function;
+
+        Data() : function(nullptr) {}
+    } data;
+
+    Validator(const Kind kind) : kind(kind), data() {}
+
+    bool holdsCallable() const { return kind == Kind::CUSTOM || kind == Kind::OPTION_SET; }
+
+    template <typename F>
+    const F &getCallable() const { return static_cast<const Shared<F> *>(data.shared.callable)->function; }
+
+    void retain()
+    {
+        if (holdsCallable())
+            data.shared.callable->references++;
+    }
+
+    void release()
+    {
+        if (holdsCallable() && --data.shared.callable->references == 0)
+            delete data.shared.callable;
+    }
+
+    const ValidationResult validate(const String &name, const String &value, const std::shared_ptr<OptionSet> &options) const;
+};
+
+#endif // __H_VALIDATOR__
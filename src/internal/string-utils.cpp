@@ -1,5 +1,8 @@
+#include <cfloat>
 #include <cmath>
-#include <ctype.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
 #include "string-utils.h"
 
 String vectorToString(const std::vector<String> &vec, const String &separator)
@@ -15,77 +18,292 @@ String vectorToString(const std::vector<String> &vec, const String &separator)
     return result;
 }
 
-bool tryGetInt(const String &value, const int start, const int length, int *result)
+namespace
 {
-    if (length == 0 || start + length > value.length())
-        return false;
+    inline bool isDigit(const char c)
+    {
+        return c >= '0' && c <= '9';
+    }
 
-    *result = 0;
-    int sign = 1;
-    int i = start;
+    /**
+     * @brief Parses the digits in [`text`, `end`) into `value`, fails if there are no digits, if a character is not a digit or if the value exceeds `limit`.
+     */
+    bool parseDigits(const char *text, const char *end, const uint64_t limit, uint64_t *value)
+    {
+        if (text == end)
+            return false;
+        uint64_t result = 0;
+        for (; text != end; text++)
+        {
+            const unsigned int digit = static_cast<unsigned char>(*text) - '0';
+            if (digit > 9)
+                return false;
+            if (result > (limit - digit) / 10)
+                return false;
+            result = result * 10 + digit;
+        }
+        *value = result;
+        return true;
+    }
 
-    if (value[i] == '-')
+    /**
+     * @brief Parses an optional sign and digits, the magnitude may be up to `positiveLimit` (or one more if negative, for two's complement minimums).
+     */
+    bool parseSigned(const char *text, const size_t length, const uint64_t positiveLimit, bool *negative, uint64_t *magnitude)
     {
-        if (length == 1)
-            return false; // Only a '-' sign is not valid.
-        sign = -1;
-        i++;
+        const char *end = text + length;
+        *negative = text != end && *text == '-';
+        if (text != end && (*text == '-' || *text == '+'))
+            text++;
+        return parseDigits(text, end, *negative ? positiveLimit + 1 : positiveLimit, magnitude);
     }
 
-    for (; i < start + length; i++)
+    /// @brief The powers of ten that a double represents exactly.
+    constexpr double exactPowersOfTen[] = {1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+                                           1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22};
+    constexpr int MAX_EXACT_POWER = 22;
+    /// @brief Integers up to 2^53 are exactly represented by a double.
+    constexpr uint64_t MAX_EXACT_MANTISSA = 1ULL << 53;
+    /// @brief The powers of ten that a float represents exactly.
+    constexpr float exactFloatPowersOfTen[] = {1e0f, 1e1f, 1e2f, 1e3f, 1e4f, 1e5f, 1e6f, 1e7f, 1e8f, 1e9f, 1e10f};
+    constexpr int MAX_EXACT_FLOAT_POWER = 10;
+    /// @brief Integers up to 2^24 are exactly represented by a float.
+    constexpr uint64_t MAX_EXACT_FLOAT_MANTISSA = 1ULL << 24;
+    /// @brief The significant digits that always fit in a `uint64_t`.
+    constexpr int MAX_MANTISSA_DIGITS = 19;
+
+    /**
+     * @brief A number read by `scanDecimal`: `mantissa` × 10^`exponent`, with its sign.
+     */
+    struct Decimal
     {
-        char c = value[i];
-        if (!isdigit(c))
+        bool negative;
+        uint64_t mantissa;
+        int exponent;
+        /// @brief Whether non-zero digits did not fit in the mantissa, or the exponent could not be read: only `strtod`/`strtof` can convert it.
+        bool inexact;
+    };
+
+    /**
+     * @brief Reads the sign, the first 19 significant digits and the decimal exponent of a floating point number.
+     *
+     * @return false if the text is not a number.
+     */
+    bool scanDecimal(const char *text, const size_t length, Decimal *decimal)
+    {
+        const char *position = text;
+        const char *end = text + length;
+        decimal->negative = position != end && *position == '-';
+        if (position != end && (*position == '-' || *position == '+'))
+            position++;
+
+        uint64_t mantissa = 0;
+        int significantDigits = 0;
+        int exponent = 0;
+        bool hasDigits = false;
+        bool truncated = false;
+        for (; position != end && isDigit(*position); position++)
+        {
+            hasDigits = true;
+            if (significantDigits < MAX_MANTISSA_DIGITS)
+            {
+                mantissa = mantissa * 10 + (*position - '0');
+                if (mantissa != 0)
+                    significantDigits++;
+            }
+            else
+            {
+                exponent++;
+                truncated |= *position != '0';
+            }
+        }
+        if (position != end && *position == '.')
+        {
+            for (position++; position != end && isDigit(*position); position++)
+            {
+                hasDigits = true;
+                if (significantDigits < MAX_MANTISSA_DIGITS)
+                {
+                    mantissa = mantissa * 10 + (*position - '0');
+                    if (mantissa != 0)
+                        significantDigits++;
+                    exponent--;
+                }
+                else
+                    truncated |= *position != '0';
+            }
+        }
+        if (!hasDigits)
             return false;
 
-        *result = *result * 10 + (c - '0');
+        if (position != end && (*position == 'e' || *position == 'E'))
+        {
+            int32_t explicitExponent;
+            position++;
+            if (position == end)
+                return false;
+            // Larger exponents are out of range anyway (or zero), strtod/strtof decide.
+            if (!tryParseInt32(position, end - position, &explicitExponent) || explicitExponent > 100000 || explicitExponent < -100000)
+                truncated = true;
+            else
+                exponent += explicitExponent;
+            position = end;
+        }
+        if (position != end)
+            return false;
+
+        decimal->mantissa = mantissa;
+        decimal->exponent = exponent;
+        decimal->inexact = truncated;
+        return true;
     }
 
-    *result *= sign;
-    return true;
+    /**
+     * @brief Converts the text with `convert` (`strtod` or `strtof`), for the inputs that the fast paths can't convert exactly.
+     */
+    template <typename T>
+    bool parseSlow(const char *text, const size_t length, T (*convert)(const char *, char **), T *result)
+    {
+        char buffer[64];
+        String copy;
+        const char *terminated;
+        if (length < sizeof(buffer))
+        {
+            memcpy(buffer, text, length);
+            buffer[length] = '\0';
+            terminated = buffer;
+        }
+        else
+        {
+            copy.reserve(length);
+            for (size_t i = 0; i < length; i++)
+                copy += text[i];
+            terminated = copy.c_str();
+        }
+        char *end;
+        const T value = convert(terminated, &end);
+        if (end != terminated + length || std::isinf(value))
+            return false;
+        *result = value;
+        return true;
+    }
 }
 
-bool tryGetInt(const String &value, int *result)
+bool tryParseInt32(const char *text, const size_t length, int32_t *result)
 {
-    return tryGetInt(value, 0, value.length(), result);
+    bool negative;
+    uint64_t magnitude;
+    if (!parseSigned(text, length, INT32_MAX, &negative, &magnitude))
+        return false;
+    *result = negative ? static_cast<int32_t>(0 - magnitude) : static_cast<int32_t>(magnitude);
+    return true;
 }
 
-bool tryGetFloat(const String &value, float *result)
+bool tryParseInt64(const char *text, const size_t length, int64_t *result)
 {
-    if (value.isEmpty())
+    bool negative;
+    uint64_t magnitude;
+    if (!parseSigned(text, length, INT64_MAX, &negative, &magnitude))
         return false;
+    *result = negative ? static_cast<int64_t>(0 - magnitude) : static_cast<int64_t>(magnitude);
+    return true;
+}
+
+bool tryParseUInt64(const char *text, const size_t length, uint64_t *result)
+{
+    if (length != 0 && *text == '+')
+        return parseDigits(text + 1, text + length, UINT64_MAX, result);
+    return parseDigits(text, text + length, UINT64_MAX, result);
+}
 
-    int decimalPoint = value.indexOf('.');
-    // No decimal point, parse it as an int
-    if (decimalPoint == -1)
+bool tryParseDouble(const char *text, const size_t length, double *result)
+{
+    Decimal decimal;
+    if (!scanDecimal(text, length, &decimal))
+        return false;
+    // Fast path: both the mantissa and the power of ten are exact, so a single multiplication or division rounds correctly.
+    if (!decimal.inexact && decimal.mantissa <= MAX_EXACT_MANTISSA && decimal.exponent >= -MAX_EXACT_POWER && decimal.exponent <= MAX_EXACT_POWER)
     {
-        int intResult;
-        bool success = tryGetInt(value, &intResult);
-        *result = static_cast<float>(intResult);
-        return success;
+        double value = static_cast<double>(decimal.mantissa);
+        value = decimal.exponent < 0 ? value / exactPowersOfTen[-decimal.exponent] : value * exactPowersOfTen[decimal.exponent];
+        *result = decimal.negative ? -value : value;
+        return true;
     }
-
-    // Check for more than decimal points
-    if (value.indexOf('.', decimalPoint + 1) != -1)
+    if (decimal.mantissa == 0 && !decimal.inexact)
     {
-        return false;
+        *result = decimal.negative ? -0.0 : 0.0;
+        return true;
     }
+    return parseSlow(text, length, strtod, result);
+}
 
-    // Read the integer part and the fractional part as ints
-    int integerPart, fractionalPart;
-    int fractionalPartLength = value.length() - decimalPoint - 1;
-    bool success = tryGetInt(value, 0, decimalPoint, &integerPart) &&
-                   tryGetInt(value, decimalPoint + 1, fractionalPartLength, &fractionalPart);
-
-    // if the fraction is negative, it means the input has '-' sign in it.
-    if (!success || fractionalPart < 0)
+bool tryParseFloat(const char *text, const size_t length, float *result)
+{
+    // Not through a double: rounding to a double first and then to a float can be off by one ulp.
+    Decimal decimal;
+    if (!scanDecimal(text, length, &decimal))
         return false;
+    if (!decimal.inexact && decimal.mantissa <= MAX_EXACT_FLOAT_MANTISSA && decimal.exponent >= -MAX_EXACT_FLOAT_POWER &&
+        decimal.exponent <= MAX_EXACT_FLOAT_POWER)
+    {
+        float value = static_cast<float>(decimal.mantissa);
+        value = decimal.exponent < 0 ? value / exactFloatPowersOfTen[-decimal.exponent] : value * exactFloatPowersOfTen[decimal.exponent];
+        *result = decimal.negative ? -value : value;
+        return true;
+    }
+    if (decimal.mantissa == 0 && !decimal.inexact)
+    {
+        *result = decimal.negative ? -0.0f : 0.0f;
+        return true;
+    }
+    return parseSlow(text, length, strtof, result);
+}
 
-    if (integerPart < 0)
+String formatFloat(const float value)
+{
+    char buffer[32];
+    for (int precision = 6; precision < 9; precision++)
     {
-        fractionalPart = -fractionalPart;
+        const int length = snprintf(buffer, sizeof(buffer), "%.*g", precision, value);
+        float parsed;
+        if (tryParseFloat(buffer, length, &parsed) && parsed == value)
+            return String(buffer);
     }
+    snprintf(buffer, sizeof(buffer), "%.9g", value);
+    return String(buffer);
+}
 
-    *result = integerPart + static_cast<float>(fractionalPart) / pow(10.0f, fractionalPartLength);
+String formatDouble(const double value)
+{
+    char buffer[32];
+    for (int precision = 15; precision < 17; precision++)
+    {
+        const int length = snprintf(buffer, sizeof(buffer), "%.*g", precision, value);
+        double parsed;
+        if (tryParseDouble(buffer, length, &parsed) && parsed == value)
+            return String(buffer);
+    }
+    snprintf(buffer, sizeof(buffer), "%.17g", value);
+    return String(buffer);
+}
+
+bool tryGetInt(const String &value, const int start, const int length, int *result)
+{
+    if (start < 0 || length < 0 || static_cast<unsigned int>(start + length) > value.length())
+        return false;
+    int32_t parsed;
+    if (!tryParseInt32(value.c_str() + start, length, &parsed))
+        return false;
+    *result = parsed;
     return true;
 }
+
+bool tryGetInt(const String &value, int *result)
+{
+    return tryGetInt(value, 0, value.length(), result);
+}
+
+bool tryGetFloat(const String &value, float *result)
+{
+    return tryParseFloat(value.c_str(), value.length(), result);
+}
@@ -1,6 +1,8 @@
 #ifndef __H_STRING_UTILS__
 #define __H_STRING_UTILS__
 #include <WString.h>
+#include <stddef.h>
+#include <stdint.h>
 #include <vector>
 
 /**
@@ -39,4 +41,30 @@ bool tryGetInt(const String &value, int *result);
  */
 bool tryGetFloat(const String &value, float *result);
 
+#pragma region Numeric parsers
+/*
+ * Parsers for `length` characters starting at `text` (no null terminator needed), that accept the whole range exactly:
+ * - Integers are an optional sign ('-' or '+', not for unsigned) followed by decimal digits, values out of range are rejected.
+ * - Floating point numbers are an optional sign, digits with an optional decimal point ("1", "1.5", ".5", "5.") and an optional exponent ("1e-3"),
+ *   rounded once to the nearest value of the type (floats are not parsed as doubles first), values out of range are rejected
+ *   (infinity and NaN are not accepted).
+ * Whitespace or any other character makes the parsing fail.
+ * They return `true` if the text was converted successfully, otherwise `false` and `result` is not changed.
+ */
+bool tryParseInt32(const char *text, const size_t length, int32_t *result);
+bool tryParseInt64(const char *text, const size_t length, int64_t *result);
+bool tryParseUInt64(const char *text, const size_t length, uint64_t *result);
+bool tryParseFloat(const char *text, const size_t length, float *result);
+bool tryParseDouble(const char *text, const size_t length, double *result);
+
+/**
+ * @brief The shortest text that parses back to exactly `value` (e.g. "0.1" rather than "0.100000001").
+ */
+String formatFloat(const float value);
+/**
+ * @brief The shortest text that parses back to exactly `value` (e.g. "0.1" rather than "0.10000000000000001").
+ */
+String formatDouble(const double value);
+#pragma endregion
+
 #endif
\ No newline at end of file